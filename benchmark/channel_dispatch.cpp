@@ -0,0 +1,95 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 11:31:18
+ * @LastEditTime: 2026-10-19 11:31:18
+ */
+
+// Channel::HandlerEvent 单核分发速度压测
+// 和原来 std::function + std::bind 回调、每个事件lock一次weak_ptr 的写法对比
+// 用法: channel_dispatch [事件数]
+
+#include <EventLoop.h>
+#include <Channel.h>
+#include <TimeStamp.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+class Handler
+{
+public:
+    Handler() : reads_(0) {}
+    void handleRead(TimeStamp) { ++reads_; }
+    long reads() const { return reads_; }
+
+private:
+    long reads_;
+};
+
+// 模拟改造前的Channel：std::function回调，每个事件lock一次tie_
+class OldChannel
+{
+public:
+    void setReadCallback(std::function<void(TimeStamp)> cb) { readCallback_ = std::move(cb); }
+    void tie(const std::shared_ptr<void> &obj) { tie_ = obj; }
+    void handleEvent(TimeStamp receiveTime)
+    {
+        std::shared_ptr<void> guard = tie_.lock();
+        if (guard && (revents_ & (EPOLLIN | EPOLLPRI)) && readCallback_)
+            readCallback_(receiveTime);
+    }
+    int revents_ = EPOLLIN;
+
+private:
+    std::weak_ptr<void> tie_;
+    std::function<void(TimeStamp)> readCallback_;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    long events = argc > 1 ? atol(argv[1]) : 50000000;
+    TimeStamp now = TimeStamp::now();
+
+    EventLoop loop;
+    int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    std::shared_ptr<Handler> handler = std::make_shared<Handler>();
+
+    Channel channel(&loop, fd);
+    channel.setReadCallback(Channel::ReadEventCallback::fromMethod<Handler, &Handler::handleRead>(handler.get()));
+    channel.tie(handler);
+    channel.set_revents(EPOLLIN);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < events; ++i)
+        channel.HandlerEvent(now);
+    double elapsed = secondsSince(start);
+    printf("delegate        events=%ld seconds=%.3f events_per_sec=%.0f ns_per_event=%.2f\n",
+           handler->reads(), elapsed, events / elapsed, elapsed * 1e9 / events);
+
+    std::shared_ptr<Handler> oldHandler = std::make_shared<Handler>();
+    OldChannel oldChannel;
+    oldChannel.setReadCallback(std::bind(&Handler::handleRead, oldHandler.get(), std::placeholders::_1));
+    oldChannel.tie(oldHandler);
+
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < events; ++i)
+        oldChannel.handleEvent(now);
+    elapsed = secondsSince(start);
+    printf("std::function   events=%ld seconds=%.3f events_per_sec=%.0f ns_per_event=%.2f\n",
+           oldHandler->reads(), elapsed, events / elapsed, elapsed * 1e9 / events);
+
+    ::close(fd);
+    return 0;
+}
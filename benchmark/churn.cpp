@@ -0,0 +1,130 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 10:40:02
+ * @LastEditTime: 2026-10-19 10:40:02
+ */
+
+// 连接风暴压测：客户端不停地 建立连接 -> 发一个字节 -> 收到回显 -> 关闭，统计服务端每秒能处理的连接数
+// 同时输出进程的峰值RSS，以及连接建立/断开各阶段（见PhaseStats）的调用次数和线程CPU时间
+// 用法: churn [subloop线程数] [客户端线程数] [持续秒数] [端口]
+
+#include <EventLoop.h>
+#include <InetAddress.h>
+#include <TcpServer.h>
+#include <TcpConnection.h>
+#include <Buffer.h>
+#include <PhaseStats.h>
+
+#include <arpa/inet.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static std::atomic<bool> g_running(true);
+static std::atomic<long> g_completed(0);
+static std::atomic<long> g_failed(0);
+
+// 回显一次后立即关闭连接
+static void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp)
+{
+    conn->send(buf->retrieveAllString());
+    conn->shutdown();
+}
+
+static void clientThread(uint16_t port)
+{
+    sockaddr_in addr;
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    while (g_running)
+    {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            ++g_failed;
+            if (fd >= 0)
+                ::close(fd);
+            continue;
+        }
+        char c = 'x';
+        bool ok = ::write(fd, &c, 1) == 1 && ::read(fd, &c, 1) == 1;
+        // 读到EOF说明服务端完成了一整轮 建立-收发-关闭
+        ok = ok && ::read(fd, &c, 1) == 0;
+        ::close(fd);
+        if (ok)
+            ++g_completed;
+        else
+            ++g_failed;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int ioThreads = argc > 1 ? atoi(argv[1]) : 1;
+    int clients = argc > 2 ? atoi(argv[2]) : 4;
+    int seconds = argc > 3 ? atoi(argv[3]) : 10;
+    uint16_t port = static_cast<uint16_t>(argc > 4 ? atoi(argv[4]) : 9994);
+
+    // 屏蔽库内部每个连接都会打印的日志，避免测的是终端输出速度
+    std::cout.setstate(std::ios_base::badbit);
+
+    PhaseStats::setEnabled(true);
+
+    EventLoop loop;
+    TcpServer server(&loop, InetAddress(port), "churn");
+    server.setMessageCallback(onMessage);
+    server.setConnectionCallback([](const TcpConnectionPtr &) {});
+    server.setThreadNum(ioThreads);
+    server.start();
+
+    std::vector<std::thread> threads;
+    std::thread driver([&]()
+                       {
+        for (int i = 0; i < clients; ++i)
+            threads.emplace_back(clientThread, port);
+        long last = 0;
+        for (int s = 1; s <= seconds; ++s)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            long now = g_completed;
+            fprintf(stderr, "second %d: %ld conn/s\n", s, now - last);
+            last = now;
+        }
+        g_running = false;
+        for (std::thread &t : threads)
+            t.join();
+        loop.quit(); });
+
+    loop.loop();
+    driver.join();
+
+    // ru_maxrss的单位是KB；CPU时间包含同一进程里的客户端线程
+    rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    double cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                        usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    printf("io_threads=%d clients=%d seconds=%d completed=%ld failed=%ld conn_per_sec=%.0f "
+           "peak_rss_kb=%ld process_cpu_sec=%.2f\n",
+           ioThreads, clients, seconds, g_completed.load(), g_failed.load(),
+           static_cast<double>(g_completed) / seconds, usage.ru_maxrss, cpuSeconds);
+
+    // Acceptor::handleRead的时间包含它同步调用的TcpServer::newConnection
+    PhaseStats::Snapshot phases = PhaseStats::snapshot();
+    for (int i = 0; i < PhaseStats::kNumPhases; ++i)
+    {
+        printf("phase=%s calls=%llu cpu_ms=%.1f ns_per_call=%.0f\n",
+               PhaseStats::phaseName(static_cast<PhaseStats::Phase>(i)),
+               static_cast<unsigned long long>(phases.calls[i]), phases.cpuNs[i] / 1e6,
+               phases.calls[i] ? static_cast<double>(phases.cpuNs[i]) / phases.calls[i] : 0.0);
+    }
+    return 0;
+}
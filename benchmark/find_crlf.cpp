@@ -0,0 +1,134 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 20:32:07
+ * @LastEditTime: 2026-10-19 20:32:07
+ */
+
+// 分隔符查找的微基准：逐行扫描一段HTTP请求头，找出所有"\r\n"
+// 对比ByteScan各个实现、memmem、std::search，以及findEOL和memchr
+// 用法: find_crlf [每种请求头的扫描次数]
+
+#include <ByteScan.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+using FindCRLF = const char *(*)(const char *, const char *);
+
+static const char kCRLF[] = "\r\n";
+
+static const char *findByMemmem(const char *begin, const char *end)
+{
+    return static_cast<const char *>(memmem(begin, end - begin, kCRLF, 2));
+}
+
+static const char *findByStdSearch(const char *begin, const char *end)
+{
+    const char *p = std::search(begin, end, kCRLF, kCRLF + 2);
+    return p == end ? nullptr : p;
+}
+
+static const char *findEOLByMemchr(const char *begin, const char *end)
+{
+    return static_cast<const char *>(memchr(begin, '\n', end - begin));
+}
+
+static const char *findEOLScalar(const char *begin, const char *end)
+{
+    return ByteScan::findByteScalar(begin, end, '\n');
+}
+
+static const char *findEOLAvx2(const char *begin, const char *end)
+{
+    return ByteScan::findByteAvx2(begin, end, '\n');
+}
+
+// 生成一个大约size字节的请求头，行长和真实浏览器请求相近
+static std::string makeHeaders(size_t size)
+{
+    std::string headers = "GET /api/v1/quotes?symbol=AAPL&fields=bid,ask,last HTTP/1.1\r\n"
+                          "Host: market.example.com\r\n"
+                          "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+                          "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+                          "Accept-Encoding: gzip, deflate, br\r\n"
+                          "Accept-Language: en-US,en;q=0.9\r\n"
+                          "Connection: keep-alive\r\n";
+    int i = 0;
+    while (headers.size() + 4 < size)
+    {
+        // 大的请求头主要是Cookie这类长行
+        std::string line = "X-Trace-" + std::to_string(i++) + ": ";
+        line.append(std::min<size_t>(size - headers.size(), 120 + i * 37 % 300), 'a' + i % 26);
+        headers += line + "\r\n";
+    }
+    headers += "\r\n";
+    return headers;
+}
+
+// 扫描iterations次请求头中的所有行，返回每次扫描的纳秒数
+static double scan(FindCRLF find, const std::string &headers, long iterations, size_t delimiterLen, long *lines)
+{
+    const char *begin = headers.data();
+    const char *end = begin + headers.size();
+    long found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        const char *p = begin;
+        const char *eol;
+        while ((eol = find(p, end)) != nullptr)
+        {
+            ++found;
+            p = eol + delimiterLen;
+        }
+        __asm__ __volatile__("" ::: "memory");
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    *lines = found / iterations;
+    return ns / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = argc > 1 ? atol(argv[1]) : 200000;
+    printf("# ByteScan dispatch: %s\n", ByteScan::implName());
+
+    struct Method
+    {
+        const char *name;
+        FindCRLF find;
+        size_t delimiterLen;
+    };
+    const Method methods[] = {
+        {"findCRLF", ByteScan::findCRLF, 2},
+        {"findCRLF_sse2", ByteScan::findCRLFSse2, 2},
+        {"findCRLF_avx2", ByteScan::findCRLFAvx2, 2},
+        {"findCRLF_scalar", ByteScan::findCRLFScalar, 2},
+        {"memmem", findByMemmem, 2},
+        {"std::search", findByStdSearch, 2},
+        {"findEOL", ByteScan::findEOL, 1},
+        {"findEOL_avx2", findEOLAvx2, 1},
+        {"memchr", findEOLByMemchr, 1},
+        {"findEOL_scalar", findEOLScalar, 1},
+    };
+
+    const size_t sizes[] = {256, 700, 2048, 8192};
+    for (size_t size : sizes)
+    {
+        std::string headers = makeHeaders(size);
+        long scaled = iterations * 700 / static_cast<long>(headers.size()) + 1;
+        for (const Method &m : methods)
+        {
+            long lines = 0;
+            double ns = scan(m.find, headers, scaled, m.delimiterLen, &lines);
+            printf("method=%-16s header_bytes=%-5zu lines=%-3ld ns_per_header=%-9.1f gb_per_sec=%.2f\n",
+                   m.name, headers.size(), lines, ns, headers.size() / ns);
+        }
+    }
+    return 0;
+}
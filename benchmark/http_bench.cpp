@@ -0,0 +1,206 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:48:20
+ * @LastEditTime: 2026-10-19 19:48:20
+ */
+
+// HttpServer 每秒请求数压测，仿照wrk：每个客户端线程用epoll驱动若干条keep-alive连接，
+// 每条连接保持pipeline个未完成的请求，收到一个响应就补发一个
+// 用法: http_bench [subloop线程数] [客户端线程数] [连接数] [持续秒数] [pipeline深度] [路径] [端口]
+// 路径为 / 时返回固定的短响应，为 /chunked 时返回chunked编码的响应
+
+#include <EventLoop.h>
+#include <InetAddress.h>
+#include <HttpServer.h>
+#include <HttpRequest.h>
+#include <HttpResponse.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::atomic<bool> g_running(true);
+static std::atomic<long> g_requests(0);
+static std::atomic<long> g_bytes(0);
+static std::atomic<long> g_errors(0);
+
+static void onRequest(const HttpRequest &req, HttpResponse *resp)
+{
+    if (req.path() == "/")
+    {
+        resp->setContentType("text/plain");
+        resp->setBody("hello, world\n");
+    }
+    else if (req.path() == "/chunked")
+    {
+        resp->setContentType("text/plain");
+        resp->beginChunked();
+        resp->writeChunk("hello, ");
+        resp->writeChunk("chunked ");
+        resp->writeChunk("world\n");
+        resp->endChunked();
+    }
+    else
+    {
+        resp->setStatusCode(HttpResponse::k404NotFound);
+        resp->setBody("Not Found");
+    }
+}
+
+struct ClientConn
+{
+    int fd;
+    std::string input;
+};
+
+// 从data开头切出一个完整的响应，返回它的长度，不完整时返回0；data以'\0'结尾
+static size_t splitResponse(const char *data, size_t len)
+{
+    const char *headerEnd = static_cast<const char *>(memmem(data, len, "\r\n\r\n", 4));
+    if (headerEnd == nullptr)
+        return 0;
+    size_t headerLen = headerEnd + 4 - data;
+    const char *cl = strcasestr(data, "Content-Length:");
+    if (cl != nullptr && cl < headerEnd)
+    {
+        size_t bodyLen = strtoul(cl + 15, nullptr, 10);
+        return len >= headerLen + bodyLen ? headerLen + bodyLen : 0;
+    }
+    // chunked编码，以结束chunk为止
+    const char *last = static_cast<const char *>(memmem(headerEnd, data + len - headerEnd, "\r\n0\r\n\r\n", 7));
+    return last == nullptr ? 0 : last + 7 - data;
+}
+
+static void clientThread(int connections, int pipeline, uint16_t port, const std::string &path)
+{
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: 127.0.0.1\r\nUser-Agent: http_bench\r\n\r\n";
+    std::string batch;
+    for (int i = 0; i < pipeline; ++i)
+        batch += request;
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    std::vector<ClientConn> conns(connections);
+    for (int i = 0; i < connections; ++i)
+    {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (::connect(fd, (sockaddr *)&addr, sizeof addr) < 0)
+        {
+            ++g_errors;
+            ::close(fd);
+            conns[i].fd = -1;
+            continue;
+        }
+        int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        conns[i].fd = fd;
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        ::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+        ::write(fd, batch.data(), batch.size());
+    }
+
+    std::vector<epoll_event> events(connections > 0 ? connections : 1);
+    char buf[65536];
+    long requests = 0, bytes = 0;
+    while (g_running)
+    {
+        int n = ::epoll_wait(epfd, events.data(), static_cast<int>(events.size()), 100);
+        for (int i = 0; i < n; ++i)
+        {
+            ClientConn &conn = conns[events[i].data.u32];
+            ssize_t nr = ::read(conn.fd, buf, sizeof buf);
+            if (nr <= 0)
+            {
+                ++g_errors;
+                ::epoll_ctl(epfd, EPOLL_CTL_DEL, conn.fd, nullptr);
+                continue;
+            }
+            bytes += nr;
+            conn.input.append(buf, nr);
+            size_t consumed = 0, len = 0;
+            std::string more;
+            while ((len = splitResponse(conn.input.data() + consumed, conn.input.size() - consumed)) > 0)
+            {
+                consumed += len;
+                ++requests;
+                more += request;
+            }
+            conn.input.erase(0, consumed);
+            if (!more.empty())
+                ::write(conn.fd, more.data(), more.size());
+        }
+    }
+    g_requests += requests;
+    g_bytes += bytes;
+    for (ClientConn &conn : conns)
+    {
+        if (conn.fd >= 0)
+            ::close(conn.fd);
+    }
+    ::close(epfd);
+}
+
+int main(int argc, char *argv[])
+{
+    int ioThreads = argc > 1 ? atoi(argv[1]) : 1;
+    int clientThreads = argc > 2 ? atoi(argv[2]) : 2;
+    int connections = argc > 3 ? atoi(argv[3]) : 100;
+    int seconds = argc > 4 ? atoi(argv[4]) : 10;
+    int pipeline = argc > 5 ? atoi(argv[5]) : 1;
+    std::string path = argc > 6 ? argv[6] : "/";
+    uint16_t port = static_cast<uint16_t>(argc > 7 ? atoi(argv[7]) : 9995);
+
+    std::cout.setstate(std::ios_base::badbit);
+
+    EventLoop loop;
+    HttpServer server(&loop, InetAddress(port), "http_bench");
+    server.setHttpCallback(onRequest);
+    server.setThreadNum(ioThreads);
+    server.start();
+
+    std::thread driver([&]()
+                       {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < clientThreads; ++i)
+        {
+            int n = connections / clientThreads + (i < connections % clientThreads ? 1 : 0);
+            threads.emplace_back(clientThread, n, pipeline, port, path);
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        g_running = false;
+        for (std::thread &t : threads)
+            t.join();
+        loop.quit(); });
+
+    loop.loop();
+    driver.join();
+
+    printf("io_threads=%d client_threads=%d connections=%d pipeline=%d path=%s seconds=%d "
+           "requests=%ld errors=%ld requests_per_sec=%.0f transfer_mb_per_sec=%.2f\n",
+           ioThreads, clientThreads, connections, pipeline, path.c_str(), seconds,
+           g_requests.load(), g_errors.load(), static_cast<double>(g_requests) / seconds,
+           static_cast<double>(g_bytes) / seconds / (1024 * 1024));
+    return 0;
+}
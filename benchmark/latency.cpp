@@ -0,0 +1,342 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 17:20:05
+ * @LastEditTime: 2026-10-20 17:20:05
+ */
+
+// 请求/响应延迟压测：回显TcpServer，客户端每条连接发size字节的请求，收齐size字节的回显算一次响应
+// closed模式：每条连接收到响应后立即发下一个请求，测的是服务端在饱和负载下的延迟
+// open模式：按固定速率发请求，不管前面的响应回来没有；延迟从"本该发送的时刻"算起，
+//           客户端自己卡住晚发的请求也计入延迟，修正了coordinated omission（同时输出未修正的结果作对比）
+// 延迟以纳秒记录在HDR风格的对数-线性直方图中，输出 p50/p90/p99/p99.9/p99.99/max，单位微秒
+// 用法: latency [closed|open] [消息大小] [连接数] [IO线程数] [持续秒数] [open模式的总速率(请求/秒)] [端口]
+
+#include <EventLoop.h>
+#include <EventLoopThreadPool.h>
+#include <InetAddress.h>
+#include <TcpServer.h>
+#include <TcpClient.h>
+#include <TcpConnection.h>
+#include <Buffer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int64_t nowNs()
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// HDR风格的直方图：值小于kSubBuckets时每个值一个桶，之后每个2的幂区间分成kSubBuckets/2个线性子桶，
+// 相对误差不超过 2/kSubBuckets（<1%），任意量级的值都只占几千个计数器，记录一次只是几次位运算
+class Histogram
+{
+public:
+    static const int kSubBucketBits = 8;
+    static const int64_t kSubBuckets = 1 << kSubBucketBits;
+    static const int64_t kHalf = kSubBuckets / 2;
+
+    Histogram() : counts_(kSubBuckets + (64 - kSubBucketBits) * kHalf, 0), total_(0), max_(0) {}
+
+    void record(int64_t value)
+    {
+        if (value < 0)
+            value = 0;
+        ++counts_[index(value)];
+        ++total_;
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const Histogram &other)
+    {
+        for (size_t i = 0; i < counts_.size(); ++i)
+            counts_[i] += other.counts_[i];
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    // 第p百分位的值，返回所在桶的上界（和HdrHistogram的highestEquivalentValue一致）
+    int64_t percentile(double p) const
+    {
+        if (total_ == 0)
+            return 0;
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * total_ + 0.5);
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+                return std::min(highestEquivalent(i), max_);
+        }
+        return max_;
+    }
+
+    uint64_t count() const { return total_; }
+    int64_t max() const { return max_; }
+
+private:
+    static size_t index(int64_t value)
+    {
+        if (value < kSubBuckets)
+            return static_cast<size_t>(value);
+        int msb = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+        int shift = msb - kSubBucketBits + 1;
+        int64_t top = value >> shift; // [kHalf, kSubBuckets)
+        return static_cast<size_t>(kSubBuckets + (shift - 1) * kHalf + (top - kHalf));
+    }
+
+    static int64_t highestEquivalent(size_t idx)
+    {
+        if (static_cast<int64_t>(idx) < kSubBuckets)
+            return static_cast<int64_t>(idx);
+        int64_t k = static_cast<int64_t>(idx) - kSubBuckets;
+        int shift = static_cast<int>(k / kHalf) + 1;
+        int64_t top = k % kHalf + kHalf;
+        return ((top + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts_;
+    uint64_t total_;
+    int64_t max_;
+};
+
+struct Options
+{
+    bool openLoop;
+    size_t size;
+    int connections;
+    int threads;
+    int seconds;
+    double rate; // open模式下所有连接的总速率
+    uint16_t port;
+};
+
+static std::atomic<bool> g_recording(false);
+static std::atomic<bool> g_running(true);
+
+// 一条连接，所有成员只在连接所在的loop线程中访问
+class Session
+{
+public:
+    Session(EventLoop *loop, const Options &opt, std::atomic<int> *connected)
+        : loop_(loop),
+          opt_(opt),
+          client_(loop, InetAddress(opt.port, "127.0.0.1"), "latency_client"),
+          request_(opt.size, 'l'),
+          interval_(opt.openLoop ? static_cast<int64_t>(1e9 * opt.connections / opt.rate) : 0),
+          nextIntended_(0),
+          sent_(0)
+    {
+        client_.setConnectionCallback([this, connected](const TcpConnectionPtr &conn)
+                                      {
+            if (conn->connected())
+            {
+                conn->setTcpNoDelay(true);
+                conn_ = conn;
+                ++*connected;
+            } });
+        client_.setMessageCallback(std::bind(&Session::onMessage, this, std::placeholders::_1,
+                                             std::placeholders::_2, std::placeholders::_3));
+    }
+
+    void connect() { client_.connect(); }
+
+    // 在loop线程中开始发请求
+    void start()
+    {
+        if (!conn_)
+            return;
+        if (!opt_.openLoop)
+        {
+            send(nowNs());
+            return;
+        }
+        // 各连接错开起始时间，避免所有请求挤在同一时刻
+        nextIntended_ = nowNs() + static_cast<int64_t>(interval_ * (static_cast<double>(rand()) / RAND_MAX));
+        double tick = std::max(interval_ / 1e9, 0.0001);
+        loop_->runEvery(tick, std::bind(&Session::onTick, this));
+    }
+
+    const Histogram &corrected() const { return corrected_; }
+    const Histogram &raw() const { return raw_; }
+    EventLoop *getLoop() const { return loop_; }
+
+private:
+    // open模式：把到期的请求全部补发，晚发的请求仍然按本该发送的时刻计算延迟
+    void onTick()
+    {
+        if (!g_running)
+            return;
+        int64_t now = nowNs();
+        while (nextIntended_ <= now)
+        {
+            send(nextIntended_);
+            nextIntended_ += interval_;
+        }
+    }
+
+    void send(int64_t intended)
+    {
+        inflight_.push_back(std::make_pair(intended, nowNs()));
+        conn_->send(request_);
+        ++sent_;
+    }
+
+    void onMessage(const TcpConnectionPtr &, Buffer *buf, TimeStamp)
+    {
+        // 回显按顺序返回，每收齐size字节对应最早的一个在途请求
+        while (buf->readableBytes() >= opt_.size && !inflight_.empty())
+        {
+            buf->retrieve(opt_.size);
+            int64_t now = nowNs();
+            std::pair<int64_t, int64_t> req = inflight_.front();
+            inflight_.pop_front();
+            if (g_recording)
+            {
+                corrected_.record(now - req.first);
+                raw_.record(now - req.second);
+            }
+            if (!opt_.openLoop && g_running)
+                send(now);
+        }
+    }
+
+    EventLoop *loop_;
+    const Options &opt_;
+    TcpClient client_;
+    TcpConnectionPtr conn_;
+    std::string request_;
+    const int64_t interval_; // open模式下这条连接两个请求的间隔(ns)
+    int64_t nextIntended_;   // 下一个请求本该发送的时刻
+    long sent_;
+    std::deque<std::pair<int64_t, int64_t>> inflight_; // 在途请求的 (本该发送的时刻, 实际发送的时刻)
+    Histogram corrected_;                              // 从本该发送的时刻算起
+    Histogram raw_;                                    // 从实际发送的时刻算起
+};
+
+static void printResult(const char *name, const Options &opt, const Histogram &h, double seconds)
+{
+    printf("mode=%s histogram=%s size=%zu connections=%d threads=%d rate=%.0f seconds=%d "
+           "requests=%llu rps=%.0f p50_us=%.1f p90_us=%.1f p99_us=%.1f p999_us=%.1f p9999_us=%.1f max_us=%.1f\n",
+           opt.openLoop ? "open" : "closed", name, opt.size, opt.connections, opt.threads,
+           opt.openLoop ? opt.rate : 0.0, opt.seconds, static_cast<unsigned long long>(h.count()), h.count() / seconds,
+           h.percentile(50) / 1e3, h.percentile(90) / 1e3, h.percentile(99) / 1e3,
+           h.percentile(99.9) / 1e3, h.percentile(99.99) / 1e3, h.max() / 1e3);
+}
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    opt.openLoop = argc > 1 && strcmp(argv[1], "open") == 0;
+    opt.size = argc > 2 ? static_cast<size_t>(atol(argv[2])) : 64;
+    opt.connections = argc > 3 ? atoi(argv[3]) : 16;
+    opt.threads = argc > 4 ? atoi(argv[4]) : 1;
+    opt.seconds = argc > 5 ? atoi(argv[5]) : 10;
+    opt.rate = argc > 6 ? atof(argv[6]) : 20000;
+    opt.port = static_cast<uint16_t>(argc > 7 ? atoi(argv[7]) : 9998);
+    if (opt.size == 0)
+        opt.size = 1;
+
+    std::cout.setstate(std::ios_base::badbit);
+
+    std::atomic<EventLoop *> serverLoop(nullptr);
+    std::thread serverThread([&]()
+                             {
+        EventLoop loop;
+        TcpServer server(&loop, InetAddress(opt.port), "latency_server");
+        server.setConnectionCallback([](const TcpConnectionPtr &conn)
+                                     {
+            if (conn->connected())
+                conn->setTcpNoDelay(true); });
+        server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, TimeStamp)
+                                  { conn->send(buf); });
+        server.setThreadNum(opt.threads);
+        server.start();
+        serverLoop = &loop;
+        loop.loop(); });
+    while (serverLoop == nullptr)
+        std::this_thread::yield();
+
+    EventLoop loop;
+    EventLoopThreadPool pool(&loop, "latency_client");
+    pool.setThreadNum(opt.threads);
+    pool.start();
+
+    std::atomic<int> connected(0);
+    std::vector<std::unique_ptr<Session>> sessions;
+    for (int i = 0; i < opt.connections; ++i)
+    {
+        sessions.emplace_back(new Session(pool.getNextLoop(), opt, &connected));
+        sessions.back()->connect();
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (connected < opt.connections && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    for (std::unique_ptr<Session> &s : sessions)
+    {
+        Session *session = s.get();
+        session->getLoop()->runInLoop([session]()
+                                      { session->start(); });
+    }
+
+    // 热身1秒后开始记录
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    g_recording = true;
+    std::this_thread::sleep_for(std::chrono::seconds(opt.seconds));
+    g_recording = false;
+    g_running = false;
+
+    // 在各自的loop线程中合并直方图
+    Histogram corrected, raw;
+    std::mutex mutex;
+    std::condition_variable cond;
+    int merged = 0;
+    for (std::unique_ptr<Session> &s : sessions)
+    {
+        Session *session = s.get();
+        session->getLoop()->runInLoop([&, session]()
+                                      {
+            std::unique_lock<std::mutex> lock(mutex);
+            corrected.merge(session->corrected());
+            raw.merge(session->raw());
+            ++merged;
+            cond.notify_one(); });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]()
+                  { return merged == static_cast<int>(sessions.size()); });
+    }
+
+    if (opt.openLoop)
+    {
+        printResult("corrected", opt, corrected, opt.seconds);
+        printResult("uncorrected", opt, raw, opt.seconds);
+    }
+    else
+    {
+        printResult("closed", opt, raw, opt.seconds);
+    }
+    fflush(stdout);
+    // 不逐个拆连接，直接退出
+    _exit(0);
+}
@@ -0,0 +1,124 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 20:25:31
+ * @LastEditTime: 2026-10-20 20:25:31
+ */
+
+// Buffer的append/retrieve/makeSpace/readFd
+
+#include "harness.h"
+
+#include <Buffer.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+static const std::string kData(64 * 1024, 'b');
+
+// 一直追加，缓冲区到64KB后清空，清空不需要移动数据
+static void appendLoop(micro::State &state, size_t len)
+{
+    Buffer buf;
+    state.setBytesPerIteration(static_cast<long>(len));
+    state.resetTimer();
+    for (long i = 0; i < state.iterations; ++i)
+    {
+        buf.append(kData.data(), len);
+        if (buf.readableBytes() >= 64 * 1024)
+            buf.retrieveAll();
+    }
+    micro::doNotOptimize(buf.readableBytes());
+}
+
+MICRO_BENCH(buffer_append_64) { appendLoop(state, 64); }
+MICRO_BENCH(buffer_append_4k) { appendLoop(state, 4096); }
+
+// 追加后立即取走，游标回到起点，是解码一个完整消息的常见路径
+MICRO_BENCH(buffer_append_retrieve_64)
+{
+    Buffer buf;
+    state.setBytesPerIteration(64);
+    state.resetTimer();
+    for (long i = 0; i < state.iterations; ++i)
+    {
+        buf.append(kData.data(), 64);
+        micro::doNotOptimize(*buf.peek());
+        buf.retrieve(64);
+    }
+}
+
+// 整数读写：appendInt32 + readInt32
+MICRO_BENCH(buffer_append_read_int32)
+{
+    Buffer buf;
+    int32_t sum = 0;
+    state.resetTimer();
+    for (long i = 0; i < state.iterations; ++i)
+    {
+        buf.appendInt32(static_cast<int32_t>(i));
+        sum += buf.readInt32();
+    }
+    micro::doNotOptimize(sum);
+}
+
+// makeSpace的挪动分支：每次追加都放不下，但前面已经读走的空间足够，把剩下的100字节挪到开头
+MICRO_BENCH(buffer_make_space_compact)
+{
+    Buffer buf(1024);
+    buf.append(kData.data(), 1024);
+    buf.retrieve(924);
+    state.setBytesPerIteration(900);
+    state.resetTimer();
+    for (long i = 0; i < state.iterations; ++i)
+    {
+        buf.append(kData.data(), 900);
+        buf.retrieve(900);
+    }
+    micro::doNotOptimize(buf.readableBytes());
+}
+
+// makeSpace的扩容分支：新Buffer从默认大小一路扩到64KB
+MICRO_BENCH(buffer_make_space_grow_64k)
+{
+    state.setBytesPerIteration(64 * 1024);
+    for (long i = 0; i < state.iterations; ++i)
+    {
+        Buffer buf;
+        for (int j = 0; j < 64; ++j)
+            buf.append(kData.data(), 1024);
+        micro::doNotOptimize(buf.readableBytes());
+    }
+}
+
+// readFd：每次先往socketpair另一端写len字节再读出来，耗时包含一次write系统调用
+static void readFdLoop(micro::State &state, size_t len)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+        return;
+    Buffer buf;
+    int savedErrno = 0;
+    state.setBytesPerIteration(static_cast<long>(len));
+    state.resetTimer();
+    for (long i = 0; i < state.iterations; ++i)
+    {
+        if (::write(fds[0], kData.data(), len) != static_cast<ssize_t>(len))
+            break;
+        size_t got = 0;
+        while (got < len)
+        {
+            ssize_t n = buf.readFd(fds[1], &savedErrno);
+            if (n <= 0)
+                break;
+            got += n;
+        }
+        buf.retrieveAll();
+    }
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+MICRO_BENCH(buffer_read_fd_4k) { readFdLoop(state, 4096); }
+MICRO_BENCH(buffer_read_fd_64k) { readFdLoop(state, 64 * 1024); }
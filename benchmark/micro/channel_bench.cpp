@@ -0,0 +1,56 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 20:52:19
+ * @LastEditTime: 2026-10-20 20:52:19
+ */
+
+// Channel::HandlerEvent的分发开销：tie检查 + Delegate回调
+
+#include "harness.h"
+
+#include <Channel.h>
+#include <EventLoop.h>
+#include <TimeStamp.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+
+namespace
+{
+    class Handler
+    {
+    public:
+        Handler() : reads_(0), writes_(0) {}
+        void handleRead(TimeStamp) { ++reads_; }
+        void handleWrite() { ++writes_; }
+        long reads_;
+        long writes_;
+    };
+
+    // revents为读或读写时，每次HandlerEvent的耗时
+    void dispatchLoop(micro::State &state, int revents)
+    {
+        EventLoop loop;
+        int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        std::shared_ptr<Handler> handler = std::make_shared<Handler>();
+        {
+            Channel channel(&loop, fd);
+            channel.setReadCallback(Channel::ReadEventCallback::fromMethod<Handler, &Handler::handleRead>(handler.get()));
+            channel.setWriteCallback(Channel::EventCallback::fromMethod<Handler, &Handler::handleWrite>(handler.get()));
+            channel.tie(handler);
+            channel.set_revents(revents);
+            TimeStamp now = TimeStamp::now();
+            state.resetTimer();
+            for (long i = 0; i < state.iterations; ++i)
+                channel.HandlerEvent(now);
+            micro::doNotOptimize(handler->reads_ + handler->writes_);
+        }
+        ::close(fd);
+    }
+}
+
+MICRO_BENCH(channel_handle_event_read) { dispatchLoop(state, EPOLLIN); }
+MICRO_BENCH(channel_handle_event_read_write) { dispatchLoop(state, EPOLLIN | EPOLLOUT); }
@@ -0,0 +1,92 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 20:40:07
+ * @LastEditTime: 2026-10-20 20:40:07
+ */
+
+// EventLoop::queueInLoop跨线程投递的吞吐量，以及空闲loop被唤醒的往返延迟
+
+#include "harness.h"
+
+#include <EventLoop.h>
+#include <EventLoopThread.h>
+
+#include <atomic>
+#include <thread>
+
+// 当前线程不停地向另一个loop线程投递任务，直到loop执行完全部任务
+MICRO_BENCH(eventloop_queue_in_loop_cross_thread)
+{
+    EventLoopThread thread;
+    EventLoop *loop = thread.startLoop();
+    long executed = 0; // 只在loop线程中修改
+    std::atomic<bool> done(false);
+    state.resetTimer();
+    for (long i = 0; i < state.iterations; ++i)
+        loop->queueInLoop([&executed]()
+                          { ++executed; });
+    loop->queueInLoop([&done]()
+                      { done = true; });
+    while (!done)
+        std::this_thread::yield();
+    micro::doNotOptimize(executed);
+}
+
+// 四个线程同时投递，测pendingFunctors_锁竞争下的吞吐量
+MICRO_BENCH(eventloop_queue_in_loop_4_producers)
+{
+    EventLoopThread thread;
+    EventLoop *loop = thread.startLoop();
+    std::atomic<long> remaining(state.iterations);
+    state.resetTimer();
+    std::thread producers[4];
+    for (int p = 0; p < 4; ++p)
+    {
+        long count = state.iterations / 4 + (p < state.iterations % 4 ? 1 : 0);
+        producers[p] = std::thread([loop, count, &remaining]()
+                                   {
+            for (long i = 0; i < count; ++i)
+                loop->queueInLoop([&remaining]()
+                                  { remaining.fetch_sub(1, std::memory_order_relaxed); }); });
+    }
+    for (std::thread &t : producers)
+        t.join();
+    while (remaining.load() > 0)
+        std::this_thread::yield();
+}
+
+// loop阻塞在epoll_wait中时投递一个任务，等它执行完再投递下一个：eventfd唤醒 + 调度 + 执行的往返时间
+MICRO_BENCH(eventloop_wakeup_roundtrip)
+{
+    EventLoopThread thread;
+    EventLoop *loop = thread.startLoop();
+    std::atomic<long> acked(0);
+    state.resetTimer();
+    for (long i = 1; i <= state.iterations; ++i)
+    {
+        loop->queueInLoop([&acked, i]()
+                          { acked.store(i, std::memory_order_release); });
+        while (acked.load(std::memory_order_acquire) != i)
+            std::this_thread::yield();
+    }
+}
+
+// 在loop线程内部调用runInLoop，直接执行，不经过队列
+MICRO_BENCH(eventloop_run_in_loop_same_thread)
+{
+    EventLoopThread thread;
+    EventLoop *loop = thread.startLoop();
+    std::atomic<bool> done(false);
+    long iterations = state.iterations;
+    state.resetTimer();
+    loop->queueInLoop([loop, iterations, &done]()
+                      {
+        long executed = 0;
+        for (long i = 0; i < iterations; ++i)
+            loop->runInLoop([&executed]()
+                            { ++executed; });
+        micro::doNotOptimize(executed);
+        done = true; });
+    while (!done)
+        std::this_thread::yield();
+}
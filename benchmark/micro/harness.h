@@ -0,0 +1,68 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 20:10:16
+ * @LastEditTime: 2026-10-20 20:10:16
+ */
+#ifndef MICRO_HARNESS_H
+#define MICRO_HARNESS_H
+
+/*
+微基准的简易框架，不依赖Google Benchmark
+用MICRO_BENCH定义一个基准，函数体里循环state.iterations次被测操作：
+    MICRO_BENCH(buffer_append_64)
+    {
+        Buffer buf;
+        state.resetTimer(); // 不计入准备工作
+        for (long i = 0; i < state.iterations; ++i)
+            ...
+    }
+框架从1次开始成倍增加迭代次数，直到一次运行超过最短时间，再按这个次数重复运行几轮，报告最快一轮的每次耗时。
+*/
+
+#include <stdint.h>
+#include <time.h>
+
+namespace micro
+{
+    inline int64_t nowNs()
+    {
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    // 一次运行的参数和计时
+    struct State
+    {
+        long iterations; // 被测操作需要执行的次数
+        int64_t startNs; // 计时起点
+        long bytes;      // 每次操作处理的字节数，不为0时额外报告吞吐量
+
+        void resetTimer() { startNs = nowNs(); }
+        void setBytesPerIteration(long n) { bytes = n; }
+    };
+
+    using BenchFunc = void (*)(State &state);
+
+    // 注册一个基准，由MICRO_BENCH在静态初始化时调用
+    struct Registrar
+    {
+        Registrar(const char *name, BenchFunc func);
+    };
+
+    // 防止编译器把结果没被使用的计算优化掉
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobberMemory() { asm volatile("" : : : "memory"); }
+}
+
+#define MICRO_BENCH(name)                                             \
+    static void micro_bench_##name(micro::State &state);              \
+    static micro::Registrar micro_registrar_##name(#name, micro_bench_##name); \
+    static void micro_bench_##name(micro::State &state)
+
+#endif
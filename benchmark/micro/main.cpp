@@ -0,0 +1,96 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 20:10:44
+ * @LastEditTime: 2026-10-20 20:10:44
+ */
+
+// 微基准入口：Buffer、EventLoop任务队列/唤醒、Channel分发
+// 用法: microbench [名字过滤子串] [每轮最短毫秒数] [轮数]
+// 每个基准输出一行 key=value：bench=名字 iterations=次数 ns_per_op=每次耗时 ops_per_sec=每秒次数 [mb_per_sec=吞吐量]
+
+#include "harness.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Entry
+    {
+        const char *name;
+        micro::BenchFunc func;
+    };
+
+    std::vector<Entry> &registry()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    // 运行一次，返回耗时(ns)
+    int64_t runOnce(micro::BenchFunc func, long iterations, long *bytes)
+    {
+        micro::State state;
+        state.iterations = iterations;
+        state.bytes = 0;
+        state.resetTimer();
+        func(state);
+        int64_t elapsed = micro::nowNs() - state.startNs;
+        *bytes = state.bytes;
+        return elapsed > 0 ? elapsed : 1;
+    }
+}
+
+micro::Registrar::Registrar(const char *name, BenchFunc func)
+{
+    registry().push_back(Entry{name, func});
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = argc > 1 ? argv[1] : "";
+    int64_t minNs = (argc > 2 ? atol(argv[2]) : 200) * 1000000L;
+    int repetitions = argc > 3 ? atoi(argv[3]) : 3;
+
+    // 屏蔽库内部的日志
+    std::cout.setstate(std::ios_base::badbit);
+
+    std::vector<Entry> entries = registry();
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return strcmp(a.name, b.name) < 0; });
+
+    for (const Entry &entry : entries)
+    {
+        if (strstr(entry.name, filter) == nullptr)
+            continue;
+
+        // 找到一次运行超过最短时间的迭代次数
+        long iterations = 1;
+        long bytes = 0;
+        int64_t elapsed = runOnce(entry.func, iterations, &bytes);
+        while (elapsed < minNs && iterations < (1L << 40))
+        {
+            double scale = std::min(10.0, std::max(2.0, 1.4 * minNs / elapsed));
+            iterations = static_cast<long>(iterations * scale);
+            elapsed = runOnce(entry.func, iterations, &bytes);
+        }
+
+        int64_t best = elapsed;
+        for (int i = 1; i < repetitions; ++i)
+            best = std::min(best, runOnce(entry.func, iterations, &bytes));
+
+        double nsPerOp = static_cast<double>(best) / iterations;
+        printf("bench=%s iterations=%ld ns_per_op=%.2f ops_per_sec=%.0f", entry.name, iterations, nsPerOp, 1e9 / nsPerOp);
+        if (bytes > 0)
+            printf(" mb_per_sec=%.1f", bytes * 1e9 / nsPerOp / (1024 * 1024));
+        printf("\n");
+        fflush(stdout);
+    }
+    return 0;
+}
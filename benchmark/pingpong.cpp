@@ -0,0 +1,183 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 16:02:44
+ * @LastEditTime: 2026-10-20 16:02:44
+ */
+
+// pingpong吞吐量压测：客户端每条连接先发一条size字节的消息，之后服务端和客户端都把收到的数据原样发回去，
+// 统计客户端每秒收到的字节数和消息数。按 线程数 x 连接数 x 消息大小 扫描，每组配置一行 key=value 输出，方便脚本比较
+// 每组配置在单独的子进程中运行，互不影响
+// 用法: pingpong [每组秒数] [线程数列表] [连接数列表] [消息大小列表] [端口]
+// 例如: pingpong 3 1,2,4 1,10,100,1000,10000 16,1024,16384,1048576 9997
+
+#include <EventLoop.h>
+#include <EventLoopThreadPool.h>
+#include <InetAddress.h>
+#include <TcpServer.h>
+#include <TcpClient.h>
+#include <TcpConnection.h>
+#include <Buffer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const size_t kMaxInFlightBytes = 1024UL * 1024 * 1024; // 连接数x消息大小超过1GB的组合跳过，避免耗尽内存
+
+struct Config
+{
+    int threads;
+    int connections;
+    size_t size;
+    int seconds;
+    uint16_t port;
+};
+
+static std::vector<long> parseList(const char *arg)
+{
+    std::vector<long> values;
+    std::string s(arg);
+    size_t start = 0;
+    while (start < s.size())
+    {
+        size_t comma = s.find(',', start);
+        if (comma == std::string::npos)
+            comma = s.size();
+        values.push_back(atol(s.substr(start, comma - start).c_str()));
+        start = comma + 1;
+    }
+    return values;
+}
+
+static void raiseFdLimit()
+{
+    rlimit rl;
+    if (::getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max)
+    {
+        rl.rlim_cur = rl.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &rl);
+    }
+}
+
+// 一组配置：服务端和客户端各用threads个IO线程，客户端的baseLoop跑在当前线程
+static void runConfig(const Config &cfg)
+{
+    std::atomic<EventLoop *> serverLoop(nullptr);
+    std::thread serverThread([&]()
+                             {
+        EventLoop loop;
+        TcpServer server(&loop, InetAddress(cfg.port), "pingpong_server");
+        server.setConnectionCallback([](const TcpConnectionPtr &conn)
+                                     {
+            if (conn->connected())
+                conn->setTcpNoDelay(true); });
+        server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf, TimeStamp)
+                                  { conn->send(buf); });
+        server.setThreadNum(cfg.threads);
+        server.start();
+        serverLoop = &loop;
+        loop.loop(); });
+    while (serverLoop == nullptr)
+        std::this_thread::yield();
+
+    EventLoop loop;
+    EventLoopThreadPool pool(&loop, "pingpong_client");
+    pool.setThreadNum(cfg.threads);
+    pool.start();
+
+    const std::string message(cfg.size, 'p');
+    std::atomic<int> connected(0);
+    std::atomic<long long> bytesRead(0);
+    std::atomic<bool> counting(false);
+
+    std::vector<std::unique_ptr<TcpClient>> clients;
+    for (int i = 0; i < cfg.connections; ++i)
+    {
+        TcpClient *client = new TcpClient(pool.getNextLoop(), InetAddress(cfg.port, "127.0.0.1"), "pingpong_client");
+        client->setConnectionCallback([&](const TcpConnectionPtr &conn)
+                                      {
+            if (conn->connected())
+            {
+                conn->setTcpNoDelay(true);
+                ++connected;
+            } });
+        client->setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf, TimeStamp)
+                                   {
+            if (counting.load(std::memory_order_relaxed))
+                bytesRead.fetch_add(buf->readableBytes(), std::memory_order_relaxed);
+            conn->send(buf); });
+        clients.emplace_back(client);
+        client->connect();
+    }
+
+    // 等所有连接建立，最多30秒
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (connected < cfg.connections && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // 每条连接在自己的loop线程里发出第一条消息，热身一秒后开始计数
+    for (const std::unique_ptr<TcpClient> &client : clients)
+    {
+        TcpConnectionPtr conn = client->connection();
+        if (conn)
+            conn->send(message);
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    counting = true;
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(cfg.seconds));
+    counting = false;
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long bytes = bytesRead;
+    printf("threads=%d connections=%d connected=%d size=%zu seconds=%.2f bytes=%lld "
+           "mb_per_sec=%.2f msgs_per_sec=%.0f\n",
+           cfg.threads, cfg.connections, connected.load(), cfg.size, elapsed, bytes,
+           bytes / elapsed / (1024 * 1024), static_cast<double>(bytes) / cfg.size / elapsed);
+    fflush(stdout);
+    // 子进程直接退出，不逐个拆连接
+    _exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+    int seconds = argc > 1 ? atoi(argv[1]) : 3;
+    std::vector<long> threads = parseList(argc > 2 ? argv[2] : "1,2,4");
+    std::vector<long> connections = parseList(argc > 3 ? argv[3] : "1,10,100,1000,10000");
+    std::vector<long> sizes = parseList(argc > 4 ? argv[4] : "16,1024,16384,1048576");
+    uint16_t port = static_cast<uint16_t>(argc > 5 ? atoi(argv[5]) : 9997);
+
+    std::cout.setstate(std::ios_base::badbit);
+    raiseFdLimit();
+
+    for (long t : threads)
+        for (long c : connections)
+            for (long s : sizes)
+            {
+                if (static_cast<size_t>(c) * s > kMaxInFlightBytes)
+                {
+                    printf("threads=%ld connections=%ld size=%ld skipped=1\n", t, c, s);
+                    continue;
+                }
+                Config cfg = {static_cast<int>(t), static_cast<int>(c), static_cast<size_t>(s), seconds, port};
+                fflush(stdout);
+                pid_t pid = ::fork();
+                if (pid == 0)
+                    runConfig(cfg);
+                int status = 0;
+                ::waitpid(pid, &status, 0);
+                if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                    printf("threads=%ld connections=%ld size=%ld failed=1\n", t, c, s);
+            }
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 10:15:09
+ * @LastEditTime: 2026-10-20 10:15:09
+ */
+
+// RPC调用延迟压测：一条连接上保持concurrency个调用在途，分别测1字节和4KB请求的echo调用延迟
+// 用法: rpc_latency [每种大小的调用数] [在途调用数] [端口]
+
+#include <EventLoop.h>
+#include <InetAddress.h>
+#include <RpcServer.h>
+#include <RpcClient.h>
+#include <RpcChannel.h>
+#include <TcpConnection.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const uint32_t kEchoMethod = 1;
+
+using Clock = std::chrono::steady_clock;
+
+// 一轮压测：固定请求大小，保持concurrency个调用在途，直到完成total个
+class LatencyRun
+{
+public:
+    LatencyRun(const RpcChannelPtr &channel, size_t size, long total, int concurrency)
+        : channel_(channel), request_(size, 'x'), total_(total), concurrency_(concurrency),
+          issued_(0), failed_(0)
+    {
+        latencies_.reserve(total);
+    }
+
+    void start(std::function<void()> done)
+    {
+        done_ = std::move(done);
+        start_ = Clock::now();
+        for (int i = 0; i < concurrency_ && issued_ < total_; ++i)
+            issue();
+    }
+
+    void report() const
+    {
+        std::vector<double> sorted(latencies_);
+        std::sort(sorted.begin(), sorted.end());
+        auto pct = [&sorted](double p)
+        { return sorted.empty() ? 0.0 : sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))]; };
+        double sum = 0;
+        for (double v : sorted)
+            sum += v;
+        printf("size=%zu calls=%zu failed=%ld concurrency=%d seconds=%.3f calls_per_sec=%.0f "
+               "avg_us=%.2f p50_us=%.2f p99_us=%.2f p999_us=%.2f max_us=%.2f\n",
+               request_.size(), sorted.size(), failed_, concurrency_, elapsed_, sorted.size() / elapsed_,
+               sorted.empty() ? 0.0 : sum / sorted.size(), pct(0.50), pct(0.99), pct(0.999),
+               sorted.empty() ? 0.0 : sorted.back());
+    }
+
+private:
+    void issue()
+    {
+        ++issued_;
+        Clock::time_point sent = Clock::now();
+        channel_->call(kEchoMethod, request_, [this, sent](RpcChannel::Status status, const StringPiece &response)
+                       {
+            if (status == RpcChannel::kOk && response.size() == request_.size())
+                latencies_.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+            else
+                ++failed_;
+            if (issued_ < total_)
+                issue();
+            else if (static_cast<long>(latencies_.size()) + failed_ == total_)
+            {
+                elapsed_ = std::chrono::duration<double>(Clock::now() - start_).count();
+                done_();
+            } }, 5.0);
+    }
+
+    RpcChannelPtr channel_;
+    std::string request_;
+    long total_;
+    int concurrency_;
+    long issued_;
+    long failed_;
+    double elapsed_;
+    Clock::time_point start_;
+    std::vector<double> latencies_;
+    std::function<void()> done_;
+};
+
+int main(int argc, char *argv[])
+{
+    long calls = argc > 1 ? atol(argv[1]) : 200000;
+    int concurrency = argc > 2 ? atoi(argv[2]) : 1;
+    uint16_t port = static_cast<uint16_t>(argc > 3 ? atoi(argv[3]) : 9996);
+
+    std::cout.setstate(std::ios_base::badbit);
+
+    // 服务端在单独的线程里跑自己的EventLoop
+    std::atomic<EventLoop *> serverLoop(nullptr);
+    std::thread serverThread([&]()
+                             {
+        EventLoop loop;
+        RpcServer server(&loop, InetAddress(port), "rpc_latency");
+        server.registerMethod(kEchoMethod, [](const StringPiece &request, const RpcReply &reply)
+                              { reply.reply(request); });
+        server.start();
+        serverLoop = &loop;
+        loop.loop(); });
+    while (serverLoop == nullptr)
+        std::this_thread::yield();
+
+    EventLoop loop;
+    RpcClient client(&loop, InetAddress(port), "rpc_latency_client");
+    const size_t sizes[] = {1, 4096};
+    std::vector<std::unique_ptr<LatencyRun>> runs;
+    size_t current = 0;
+
+    // 按大小依次跑，前一轮结束再开始下一轮
+    std::function<void()> next = [&]()
+    {
+        if (current == sizeof sizes / sizeof sizes[0])
+        {
+            loop.quit();
+            return;
+        }
+        runs.emplace_back(new LatencyRun(client.channel(), sizes[current++], calls, concurrency));
+        runs.back()->start([&]()
+                           { loop.queueInLoop(next); });
+    };
+    client.setConnectionCallback([&](const TcpConnectionPtr &conn)
+                                 {
+        if (conn->connected())
+            next(); });
+    client.connect();
+    loop.loop();
+
+    for (const auto &run : runs)
+        run->report();
+
+    serverLoop.load()->quit();
+    serverThread.join();
+    return 0;
+}
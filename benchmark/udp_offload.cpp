@@ -0,0 +1,109 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 17:40:55
+ * @LastEditTime: 2026-10-19 17:40:55
+ */
+
+// UDP回环压测：对比 sendmmsg/recvmmsg 批量收发 和 GSO发送 + GRO接收 的每秒数据报数
+// 用法: udp_offload [每种模式的秒数] [数据报大小] [端口]
+
+#include <EventLoop.h>
+#include <EventLoopThread.h>
+#include <UdpChannel.h>
+#include <InetAddress.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+static const size_t kBurst = 64; // 每轮发送的数据报个数
+
+struct Result
+{
+    uint64_t sent;
+    uint64_t received;
+    uint64_t dropped;
+    uint64_t groPackets;
+};
+
+static Result runMode(bool offload, int seconds, size_t payloadSize, uint16_t port)
+{
+    EventLoopThread receiverThread(EventLoopThread::ThreadInitCallback(), "receiver");
+    EventLoopThread senderThread(EventLoopThread::ThreadInitCallback(), "sender");
+    EventLoop *receiverLoop = receiverThread.startLoop();
+    EventLoop *senderLoop = senderThread.startLoop();
+
+    InetAddress serverAddr(port);
+    UdpChannelPtr receiver = std::make_shared<UdpChannel>(receiverLoop, serverAddr, "receiver", false);
+    receiver->socket().setRecvBufferSize(8 * 1024 * 1024);
+    if (offload && !receiver->enableGro())
+        fprintf(stderr, "UDP_GRO not supported, receiving without GRO\n");
+    receiver->start();
+
+    UdpChannelPtr sender = std::make_shared<UdpChannel>(senderLoop, InetAddress(0), "sender", false);
+    std::string burst(kBurst * payloadSize, 'x');
+    std::atomic<bool> running(true);
+
+    // 发送线程里不停地发，每轮发完后把自己重新放回任务队列，让出机会处理其他事件
+    std::shared_ptr<std::function<void()>> pump = std::make_shared<std::function<void()>>();
+    *pump = [&, pump]()
+    {
+        if (!running)
+            return;
+        if (offload)
+        {
+            sender->sendSegmented(serverAddr, burst.data(), burst.size(), payloadSize);
+        }
+        else
+        {
+            for (size_t i = 0; i < kBurst; ++i)
+                sender->send(serverAddr, burst.data() + i * payloadSize, payloadSize);
+            sender->flush();
+        }
+        senderLoop->queueInLoop(*pump);
+    };
+    senderLoop->runInLoop(*pump);
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    running = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200)); // 等在途的数据报收完
+
+    Result result;
+    result.sent = sender->datagramsSent();
+    result.received = receiver->datagramsReceived();
+    result.dropped = sender->datagramsDropped();
+    result.groPackets = receiver->groPackets();
+
+    receiver->stop();
+    sender->stop();
+    *pump = std::function<void()>(); // 打破pump对自身的引用
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    int seconds = argc > 1 ? atoi(argv[1]) : 3;
+    size_t payloadSize = argc > 2 ? atoi(argv[2]) : 1200;
+    uint16_t port = static_cast<uint16_t>(argc > 3 ? atoi(argv[3]) : 9998);
+
+    // 屏蔽库内部的日志
+    std::cout.setstate(std::ios_base::badbit);
+
+    const char *modes[] = {"sendmmsg/recvmmsg", "gso/gro"};
+    for (int m = 0; m < 2; ++m)
+    {
+        Result r = runMode(m == 1, seconds, payloadSize, port);
+        printf("mode=%s payload=%lu seconds=%d sent=%lu received=%lu dropped=%lu gro_packets=%lu rx_pps=%.0f rx_MBps=%.1f\n",
+               modes[m], payloadSize, seconds, r.sent, r.received, r.dropped, r.groPackets,
+               static_cast<double>(r.received) / seconds,
+               static_cast<double>(r.received) * payloadSize / seconds / 1024 / 1024);
+    }
+    return 0;
+}
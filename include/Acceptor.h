@@ -11,6 +11,7 @@
 #include "noncopyable.h"
 #include "Channel.h"
 #include "Socket.h"
+#include "TimeStamp.h"
 
 class EventLoop;
 class InetAddress;
@@ -32,7 +33,7 @@ public:
     void listen();
 
 private:
-    void handleRead();
+    void handleRead(TimeStamp receiveTime);
 
     EventLoop *loop_;
     Socket acceptSocket_;
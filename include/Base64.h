@@ -0,0 +1,20 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:03:05
+ * @LastEditTime: 2026-10-19 21:03:05
+ */
+#ifndef BASE64_H
+#define BASE64_H
+
+#include <stddef.h>
+#include <string>
+
+// Base64编码(RFC 4648，标准字母表，带'='补位)
+namespace Base64
+{
+
+    std::string encode(const void *data, size_t len);
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 10:12:31
+ * @LastEditTime: 2026-10-19 10:12:31
+ */
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "noncopyable.h"
+
+/*
+BlockPool 定长内存块池
+每个EventLoop持有一个，用于TcpConnection的分配：配合std::allocate_shared，
+TcpConnection对象、它内嵌的Socket/Channel以及shared_ptr的控制块都在同一块内存上，
+连接销毁后这块内存不还给系统，而是挂到空闲链表上给下一个连接复用。
+
+连接在baseLoop线程中创建，却在subLoop线程中销毁，所以空闲链表需要加锁，
+但每个池只被两个线程访问，竞争很小。
+*/
+class BlockPool : public muduo::noncopyable
+{
+public:
+    static const size_t kDefaultMaxCached = 4096; // 空闲链表最多缓存的内存块数量
+
+    explicit BlockPool(size_t maxCached = kDefaultMaxCached);
+    ~BlockPool();
+
+    /**
+     * @description: 分配一块内存，块大小由第一次分配时确定，大小不同的请求直接走operator new
+     * @param {size_t} size 需要的字节数
+     */
+    void *allocate(size_t size);
+
+    /**
+     * @description: 归还一块内存，空闲链表未满时缓存起来，否则直接释放
+     * @param {void} *p allocate返回的地址
+     * @param {size_t} size 分配时的字节数
+     */
+    void deallocate(void *p, size_t size);
+
+    // 当前缓存的空闲块数量
+    size_t cachedBlocks() const;
+
+private:
+    mutable std::mutex mutex_;
+    size_t blockSize_;             // 池中内存块的大小，0表示还未确定
+    const size_t maxCached_;       // 空闲链表长度上限
+    std::vector<void *> freeList_; // 空闲内存块
+};
+
+// 符合标准分配器要求的适配器，让std::allocate_shared从BlockPool分配内存
+// 分配器内部持有池的shared_ptr，保证EventLoop先于连接析构时池依然有效
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(std::shared_ptr<BlockPool> pool) : pool_(std::move(pool)) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &other) : pool_(other.pool()) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(pool_->allocate(n * sizeof(T))); }
+    void deallocate(T *p, size_t n) { pool_->deallocate(p, n * sizeof(T)); }
+
+    const std::shared_ptr<BlockPool> &pool() const { return pool_; }
+
+private:
+    std::shared_ptr<BlockPool> pool_;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &lhs, const PoolAllocator<U> &rhs) { return lhs.pool() == rhs.pool(); }
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> &lhs, const PoolAllocator<U> &rhs) { return !(lhs == rhs); }
+
+#endif
@@ -27,6 +27,12 @@ prependable预留空间，用于记录数据的长度
 #include <sys/uio.h>
 #include <errno.h>
 #include <unistd.h>
+#include <stdint.h>
+#include <string.h>
+#include <endian.h>
+#include <algorithm>
+
+#include "ByteScan.h"
 
 // Buffer缓冲区类
 class Buffer
@@ -43,6 +49,16 @@ public:
      * @description: 返回可读数据的起始地址
      */
     const char *peek() const { return begin() + readerIndex_; }
+    char *peek() { return begin() + readerIndex_; } // 可以就地修改可读数据，如WebSocket的去掩码
+
+    // 在可读数据中查找分隔符，找不到时返回nullptr；带start参数的版本从start开始查找
+    // 解析时记住上次查找结束的位置，下次从那里继续，避免重复扫描（见HttpParser）
+    const char *findCRLF() const { return ByteScan::findCRLF(peek(), beginWrite()); }
+    const char *findCRLF(const char *start) const { return ByteScan::findCRLF(start, beginWrite()); }
+    const char *findEOL() const { return ByteScan::findEOL(peek(), beginWrite()); }
+    const char *findEOL(const char *start) const { return ByteScan::findEOL(start, beginWrite()); }
+    const char *findByte(char c) const { return ByteScan::findByte(peek(), beginWrite(), c); }
+    const char *findByte(const char *start, char c) const { return ByteScan::findByte(start, beginWrite(), c); }
 
     /**
      * @description: 从头开始清空数据，用于进行复位操作
@@ -77,6 +93,93 @@ public:
         return result;
     }
 
+    // 以下整数读写接口统一使用网络字节序（大端），调用者需自行保证可读数据足够
+
+    // 读出并移除一个整数
+    int64_t readInt64()
+    {
+        int64_t result = peekInt64();
+        retrieve(sizeof result);
+        return result;
+    }
+    int32_t readInt32()
+    {
+        int32_t result = peekInt32();
+        retrieve(sizeof result);
+        return result;
+    }
+    int16_t readInt16()
+    {
+        int16_t result = peekInt16();
+        retrieve(sizeof result);
+        return result;
+    }
+    int8_t readInt8()
+    {
+        int8_t result = peekInt8();
+        retrieve(sizeof result);
+        return result;
+    }
+
+    // 查看可读数据开头的整数，不移动readerIndex_
+    int64_t peekInt64() const
+    {
+        int64_t be64 = 0;
+        ::memcpy(&be64, peek(), sizeof be64);
+        return static_cast<int64_t>(be64toh(static_cast<uint64_t>(be64)));
+    }
+    int32_t peekInt32() const
+    {
+        int32_t be32 = 0;
+        ::memcpy(&be32, peek(), sizeof be32);
+        return static_cast<int32_t>(be32toh(static_cast<uint32_t>(be32)));
+    }
+    int16_t peekInt16() const
+    {
+        int16_t be16 = 0;
+        ::memcpy(&be16, peek(), sizeof be16);
+        return static_cast<int16_t>(be16toh(static_cast<uint16_t>(be16)));
+    }
+    int8_t peekInt8() const { return *peek(); }
+
+    /**
+     * @description: 往可读数据前面插入数据，利用预留的prependable空间，不需要移动已有数据
+     * @param {void} *data 要插入的数据
+     * @param {size_t} len 要插入数据的长度
+     */
+    void prepend(const void *data, size_t len)
+    {
+        if (len > prependableBytes())
+        {
+            // 预留空间不够（只有插入超过kCheapPrepend字节时才会发生），在前面补出空间
+            size_t extra = len - prependableBytes();
+            buffer_.insert(buffer_.begin(), extra, 0);
+            readerIndex_ += extra;
+            writerIndex_ += extra;
+        }
+        readerIndex_ -= len;
+        const char *d = static_cast<const char *>(data);
+        std::copy(d, d + len, begin() + readerIndex_);
+    }
+
+    // 往可读数据前面插入一个整数，用于发送前补上消息长度
+    void prependInt64(int64_t x)
+    {
+        uint64_t be64 = htobe64(static_cast<uint64_t>(x));
+        prepend(&be64, sizeof be64);
+    }
+    void prependInt32(int32_t x)
+    {
+        uint32_t be32 = htobe32(static_cast<uint32_t>(x));
+        prepend(&be32, sizeof be32);
+    }
+    void prependInt16(int16_t x)
+    {
+        uint16_t be16 = htobe16(static_cast<uint16_t>(x));
+        prepend(&be16, sizeof be16);
+    }
+    void prependInt8(int8_t x) { prepend(&x, sizeof x); }
+
     /**
      * @description: 确保缓冲区可以写入数据，空间不够则进行扩容
      * @param {size_t} len 要写入数据的长度
@@ -100,6 +203,27 @@ public:
         writerIndex_ += len;
     }
 
+    void append(const void *data, size_t len) { append(static_cast<const char *>(data), len); }
+    void append(const std::string &str) { append(str.data(), str.size()); }
+
+    // 往缓冲区里写入一个整数
+    void appendInt64(int64_t x)
+    {
+        uint64_t be64 = htobe64(static_cast<uint64_t>(x));
+        append(&be64, sizeof be64);
+    }
+    void appendInt32(int32_t x)
+    {
+        uint32_t be32 = htobe32(static_cast<uint32_t>(x));
+        append(&be32, sizeof be32);
+    }
+    void appendInt16(int16_t x)
+    {
+        uint16_t be16 = htobe16(static_cast<uint16_t>(x));
+        append(&be16, sizeof be16);
+    }
+    void appendInt8(int8_t x) { append(&x, sizeof x); }
+
     char *beginWrite() { return begin() + writerIndex_; }
     const char *beginWrite() const { return begin() + writerIndex_; }
 
@@ -190,7 +314,7 @@ private:
 
 public:
     // static const int可以在类里面初始化，是因为它既然是const的，那程序就不会再去试图初始化了
-    static const size_t kCheapPrepend = 8;   // 记录数据包的长度的变量长度，用于解决粘包问题
+    static const size_t kCheapPrepend = 8;   // 记录数据包的长度的变量长度，用于解决粘包问题（见prependInt32和LengthHeaderCodec）
     static const size_t kInitialSize = 1024; // 缓冲区长度
 
 private:
@@ -0,0 +1,42 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 20:10:33
+ * @LastEditTime: 2026-10-19 20:10:33
+ */
+#ifndef BYTE_SCAN_H
+#define BYTE_SCAN_H
+
+/*
+ByteScan 在一段内存中查找分隔符
+HTTP、RESP、memcached文本协议解析时大部分时间都花在从inputBuffer_里找"\r\n"上。
+x86上用SSE2/AVX2一次比较16/32个字节，第一次调用时按CPU是否支持AVX2选择实现，之后直接走函数指针；
+其他平台使用逐字节比较的实现。单字节查找在glibc上直接用memchr，它已经是按CPU分派的SIMD实现。
+
+所有函数在[begin, end)中查找，找不到时返回nullptr。
+*/
+namespace ByteScan
+{
+
+    // 查找字节c第一次出现的位置
+    const char *findByte(const char *begin, const char *end, char c);
+
+    // 查找"\r\n"第一次出现的位置，返回指向'\r'的指针
+    const char *findCRLF(const char *begin, const char *end);
+
+    // 查找'\n'第一次出现的位置
+    inline const char *findEOL(const char *begin, const char *end) { return findByte(begin, end, '\n'); }
+
+    // 当前使用的实现："avx2"、"sse2"或"scalar"
+    const char *implName();
+
+    // 以下是各个具体实现，供基准测试对比；CPU不支持时Avx2版本退化为Sse2版本
+    const char *findByteScalar(const char *begin, const char *end, char c);
+    const char *findByteSse2(const char *begin, const char *end, char c);
+    const char *findByteAvx2(const char *begin, const char *end, char c);
+    const char *findCRLFScalar(const char *begin, const char *end);
+    const char *findCRLFSse2(const char *begin, const char *end);
+    const char *findCRLFAvx2(const char *begin, const char *end);
+
+}
+
+#endif
@@ -11,6 +11,8 @@
 class Buffer;
 class TcpConnection;
 class TimeStamp;
+class UdpChannel;
+struct Datagram;
 
 using TcpConnectionPtr = std::shared_ptr<TcpConnection>;
 using ConnectionCallback = std::function<void(const TcpConnectionPtr &)>;
@@ -18,5 +20,10 @@ using CloseCallback = std::function<void(const TcpConnectionPtr &)>;
 using WriteCompleteCallback = std::function<void(const TcpConnectionPtr &)>;
 using MessageCallback = std::function<void(const TcpConnectionPtr &, Buffer *, TimeStamp)>;
 using HighWaterMarkCallback = std::function<void(const TcpConnectionPtr &, size_t)>;
+using TimerCallback = std::function<void()>;
+
+using UdpChannelPtr = std::shared_ptr<UdpChannel>;
+// 一次读事件收到的一批数据报，datagrams只在回调期间有效
+using DatagramCallback = std::function<void(const UdpChannelPtr &, const Datagram *datagrams, size_t count, TimeStamp)>;
 
 #endif
@@ -6,11 +6,11 @@
 #ifndef CHANNEL_H
 #define CHANNEL_H
 
-#include <functional>
 #include <memory>
 
 #include "noncopyable.h"
 #include "TimeStamp.h"
+#include "Delegate.h"
 
 class EventLoop;
 
@@ -18,11 +18,11 @@ class EventLoop;
 class Channel : public muduo::noncopyable
 {
 public:
-    // 事件回调
-    using EventCallback = std::function<void()>;
+    // 事件回调，每个IO事件都会调用，所以用Delegate而不是std::function
+    using EventCallback = Delegate<void()>;
 
     // 只读事件回调
-    using ReadEventCallback = std::function<void(TimeStamp)>;
+    using ReadEventCallback = Delegate<void(TimeStamp)>;
 
     Channel(EventLoop *loop, int fd);
     ~Channel();
@@ -30,22 +30,26 @@ public:
     void HandlerEvent(TimeStamp receive_time);
 
     // 设置可读事件回调函数
-    void setReadCallback(ReadEventCallback cb) { read_callback_ = std::move(cb); }
+    void setReadCallback(ReadEventCallback cb) { read_callback_ = cb; }
 
     // 设置可写事件回调函数
-    void setWriteCallback(EventCallback cb) { write_callback_ = std::move(cb); }
+    void setWriteCallback(EventCallback cb) { write_callback_ = cb; }
 
     // 设置关闭事件回调函数
-    void setCloseCallback(EventCallback cb) { close_callback_ = std::move(cb); }
+    void setCloseCallback(EventCallback cb) { close_callback_ = cb; }
 
     // 设置错误事件回调函数
-    void setErrorCallback(EventCallback cb) { error_callback_ = std::move(cb); }
+    void setErrorCallback(EventCallback cb) { error_callback_ = cb; }
 
     void tie(const std::shared_ptr<void> &);
 
     // 返回封装的fd
     int fd() const { return fd_; }
 
+    // 设置名字，用于慢回调等诊断信息，name的生命周期要不短于Channel（比如TcpConnection的连接名）
+    void setName(const char *name) { name_ = name; }
+    const char *name() const { return name_; }
+
     // 返回正在监听的事件
     int events() const { return events_; }
 
@@ -125,6 +129,7 @@ private:
     int events_;   // socket要监听的事件，EPOLLIN | EPOLLPRI，EPOLLPRI：带外数据
     int revents_;  // socket发生的事件
     int status_;   // channel的状态，在EpollPoller中定位了各状态
+    const char *name_; // 诊断用的名字，可以为空
 
     std::weak_ptr<void> tie_; // 用来绑定一个连接，避免连接释放后继续执行回调函数，具体使用在HandlerEvent函数中
     bool tied_;               // 是否绑定了tie_
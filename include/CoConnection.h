@@ -0,0 +1,118 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 14:32:40
+ * @LastEditTime: 2026-10-20 14:32:40
+ */
+#ifndef CO_CONNECTION_H
+#define CO_CONNECTION_H
+
+#include <string>
+
+#include "Coroutine.h"
+#include "StringPiece.h"
+#include "TcpConnection.h"
+
+/*
+CoConnection 协程方式读写TcpConnection
+在连接回调里用attach接管连接的消息、写完成、连接断开回调，之后在协程里顺序地写多步协议：
+    CoTask<> session(CoConnectionPtr c)
+    {
+        std::string line = co_await c->readUntil("\r\n");
+        co_await c->write("+OK\r\n");
+    }
+    server.setConnectionCallback([](const TcpConnectionPtr &conn) {
+        if (conn->connected())
+            coSpawn(session(CoConnection::attach(conn)));
+    });
+
+数据到来、发送缓冲区清空、连接断开时，直接在这些回调里恢复等待的协程，和回调写法一样都在连接所在的IO线程中执行。
+attach之后TcpServer上设置的连接回调不会再收到这条连接的断开通知。
+同一时刻只能有一个协程在读、一个协程在写。连接断开后读返回已经收到的不完整数据（通常为空），closed()为true。
+
+CoConnection由协程持有，连接的回调里只保存它的weak_ptr；协程结束、CoConnection释放后，连接上新到的数据会被丢弃。
+*/
+class CoConnection;
+using CoConnectionPtr = std::shared_ptr<CoConnection>;
+
+class CoConnection : public muduo::noncopyable, public std::enable_shared_from_this<CoConnection>
+{
+public:
+    // 接管conn的回调，必须在连接所在的loop线程中调用（比如连接回调里）
+    static CoConnectionPtr attach(const TcpConnectionPtr &conn);
+
+    explicit CoConnection(const TcpConnectionPtr &conn);
+
+    // co_await read(n)：读出恰好n个字节
+    auto read(size_t n) { return ReadAwaiter(this, n, std::string()); }
+
+    // co_await readUntil(delim)：读到分隔符为止，返回分隔符之前的数据，分隔符被丢弃
+    auto readUntil(const std::string &delim) { return ReadAwaiter(this, 0, delim); }
+
+    // co_await write(data)：发送数据，等到数据全部写进内核后恢复；返回连接是否还在
+    auto write(const StringPiece &data) { return WriteAwaiter(this, data); }
+
+    // co_await sleep(ms)：在连接所在的loop上等待ms毫秒
+    auto sleep(double ms) { return coSleep(loop_, ms); }
+
+    // 关闭写端，发送缓冲区中的数据会先发完
+    void shutdown() { conn_->shutdown(); }
+
+    bool closed() const { return closed_; }
+    const TcpConnectionPtr &connection() const { return conn_; }
+    EventLoop *getLoop() const { return loop_; }
+
+private:
+    class ReadAwaiter
+    {
+    public:
+        ReadAwaiter(CoConnection *owner, size_t n, std::string delim)
+            : owner_(owner), n_(n), delim_(std::move(delim)) {}
+
+        bool await_ready() { return owner_->readable(n_, delim_) || owner_->closed_; }
+        void await_suspend(std::coroutine_handle<> h) { owner_->waitRead(h, n_, delim_); }
+        std::string await_resume() { return owner_->takeRead(n_, delim_); }
+
+    private:
+        CoConnection *owner_;
+        size_t n_;          // 按长度读取时的字节数
+        std::string delim_; // 按分隔符读取时的分隔符
+    };
+
+    class WriteAwaiter
+    {
+    public:
+        WriteAwaiter(CoConnection *owner, const StringPiece &data) : owner_(owner), data_(data) {}
+
+        bool await_ready() { return owner_->startWrite(data_); }
+        void await_suspend(std::coroutine_handle<> h) { owner_->writer_ = h; }
+        bool await_resume() { return !owner_->closed_; }
+
+    private:
+        CoConnection *owner_;
+        StringPiece data_;
+    };
+
+    // 读取条件是否已经满足
+    bool readable(size_t n, const std::string &delim) const;
+    void waitRead(std::coroutine_handle<> h, size_t n, const std::string &delim);
+    std::string takeRead(size_t n, const std::string &delim);
+
+    // 发出数据，全部写进内核或者连接已断开时返回true，不需要挂起
+    bool startWrite(const StringPiece &data);
+
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+    void onWriteComplete(const TcpConnectionPtr &conn);
+    void onConnection(const TcpConnectionPtr &conn);
+
+    TcpConnectionPtr conn_;
+    EventLoop *loop_;
+    Buffer *input_;  // 连接的接收缓冲区
+    bool closed_;
+
+    std::coroutine_handle<> reader_; // 等待数据的协程
+    size_t readBytes_;               // reader_等待的字节数
+    std::string readDelim_;          // reader_等待的分隔符
+    std::coroutine_handle<> writer_; // 等待发送完成的协程
+};
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 10:02:17
+ * @LastEditTime: 2026-10-21 10:02:17
+ */
+#ifndef CONNECTION_STATS_H
+#define CONNECTION_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <atomic>
+#include <string>
+
+#include "noncopyable.h"
+
+/*
+ConnectionStats 一条TcpConnection的读写统计
+记录函数只在连接所在的IO线程中调用，计数用relaxed的load+store累加（和LoopMetrics一样），
+在handleRead/handleWrite/sendInLoop里每次系统调用只多几次普通的内存读写；任意线程都可以用snapshot()无锁读出。
+
+用来找出占用大量发送缓冲区、或者发送迟迟发不完的连接：peakOutputBytes高说明对端读得慢，
+partialWrites持续增长、outputBytes居高不下说明连接一直在等可写事件。
+*/
+class ConnectionStats : public muduo::noncopyable
+{
+public:
+    struct Snapshot
+    {
+        Snapshot();
+
+        std::string name;         // 连接名字，由TcpServer填写
+        uint64_t bytesRead;       // 读到的字节数
+        uint64_t bytesWritten;    // 写进内核的字节数
+        uint64_t readCalls;       // read/readv系统调用次数
+        uint64_t writeCalls;      // write/writev系统调用次数
+        uint64_t partialWrites;   // 没有写完的write次数（含EAGAIN），之后剩余数据要等可写事件
+        uint64_t outputBytes;     // 当前待发送的字节数（发送链加outputBuffer_）
+        uint64_t peakOutputBytes; // 待发送字节数的峰值
+        uint64_t ageNs;           // 连接建立到现在的时间
+        int64_t firstByteNs;      // 连接建立到收到第一个字节的时间，还没收到数据时为-1
+    };
+
+    ConnectionStats();
+
+    Snapshot snapshot() const;
+
+    // 下面的记录函数只能在连接所在的IO线程中调用
+    void recordEstablished();
+
+    // 一次读系统调用，n为返回值
+    void recordRead(ssize_t n)
+    {
+        add(readCalls_, 1);
+        if (n > 0)
+        {
+            if (bytesRead_.load(std::memory_order_relaxed) == 0)
+                firstByteAtNs_.store(nowNs(), std::memory_order_relaxed);
+            add(bytesRead_, n);
+        }
+    }
+
+    // 一次写系统调用，requested为要写的字节数，n为返回值
+    void recordWrite(size_t requested, ssize_t n)
+    {
+        add(writeCalls_, 1);
+        if (n > 0)
+            add(bytesWritten_, n);
+        if (n < 0 || static_cast<size_t>(n) < requested)
+            add(partialWrites_, 1);
+    }
+
+    // 待发送的字节数变化之后调用
+    void recordOutputBytes(size_t bytes)
+    {
+        outputBytes_.store(bytes, std::memory_order_relaxed);
+        if (bytes > peakOutputBytes_.load(std::memory_order_relaxed))
+            peakOutputBytes_.store(bytes, std::memory_order_relaxed);
+    }
+
+private:
+    static uint64_t nowNs();
+
+    static void add(std::atomic<uint64_t> &counter, uint64_t n)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> bytesRead_;
+    std::atomic<uint64_t> bytesWritten_;
+    std::atomic<uint64_t> readCalls_;
+    std::atomic<uint64_t> writeCalls_;
+    std::atomic<uint64_t> partialWrites_;
+    std::atomic<uint64_t> outputBytes_;
+    std::atomic<uint64_t> peakOutputBytes_;
+    std::atomic<uint64_t> establishedAtNs_; // 连接建立的时刻，CLOCK_MONOTONIC
+    std::atomic<uint64_t> firstByteAtNs_;   // 收到第一个字节的时刻，0表示还没收到
+};
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 14:02:51
+ * @LastEditTime: 2026-10-19 14:02:51
+ */
+#ifndef CONNECTOR_H
+#define CONNECTOR_H
+
+#include <functional>
+#include <memory>
+#include <atomic>
+
+#include "noncopyable.h"
+#include "InetAddress.h"
+#include "TimeStamp.h"
+#include "TimerId.h"
+
+class Channel;
+class EventLoop;
+
+/*
+Connector 主动发起连接，是TcpClient中和Acceptor对应的角色
+非阻塞connect返回EINPROGRESS后，把sockfd注册到poller上关注EPOLLOUT，
+可写时用SO_ERROR判断连接是否成功；失败则按指数退避(0.5s, 1s, 2s ... 最长30s)定时重连。
+连接成功后Connector不再管理这个sockfd，而是通过newConnectionCallback_交给TcpClient创建TcpConnection。
+*/
+class Connector : public muduo::noncopyable, public std::enable_shared_from_this<Connector>
+{
+public:
+    using NewConnectionCallback = std::function<void(int sockfd)>;
+
+    Connector(EventLoop *loop, const InetAddress &serverAddr);
+    ~Connector();
+
+    // 设置连接成功的回调
+    void setNewConnectionCallback(const NewConnectionCallback &cb) { newConnectionCallback_ = cb; }
+
+    // 开始连接，可以跨线程调用
+    void start();
+
+    // 重新开始连接，重置退避时间，必须在loop线程中调用
+    void restart();
+
+    // 停止连接，可以跨线程调用
+    void stop();
+
+    // 返回服务器地址
+    const InetAddress &serverAddress() const { return serverAddr_; }
+
+private:
+    enum States
+    {
+        kDisconnected, // 未连接
+        kConnecting,   // 正在连接
+        kConnected     // 已连接
+    };
+    static const int kMaxRetryDelayMs = 30 * 1000; // 最长重连间隔
+    static const int kInitRetryDelayMs = 500;      // 初始重连间隔
+
+    void setState(States s) { state_ = s; }
+    void startInLoop();
+    void stopInLoop();
+
+    // 发起一次非阻塞connect
+    void connect();
+
+    // connect正在进行中，关注sockfd的可写事件
+    void connecting(int sockfd);
+
+    // sockfd可写，检查连接结果
+    void handleWrite();
+    void handleError();
+
+    // 关闭sockfd，定时重连
+    void retry(int sockfd);
+
+    // 把channel从poller中移除，返回它封装的sockfd
+    int removeAndResetChannel();
+    void resetChannel();
+
+    EventLoop *loop_;
+    InetAddress serverAddr_;
+    std::atomic<bool> connect_; // 用户是否希望连接
+    std::atomic<int> state_;
+    std::unique_ptr<Channel> channel_; // 连接过程中用于关注sockfd的可写事件，连接完成就释放
+    NewConnectionCallback newConnectionCallback_;
+    int retryDelayMs_; // 下一次重连间隔
+    TimerId retryTimer_;
+};
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 14:05:18
+ * @LastEditTime: 2026-10-20 14:05:18
+ */
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+/*
+C++20协程接口，需要用 -DMYMUDUO_COROUTINE=ON 编译库，使用方也要用 -std=c++20 编译
+库的其他部分仍然只依赖C++11，不打开选项时这个头文件和CoConnection都不参与编译。
+
+CoTask<T>   协程的返回类型，惰性启动：co_await一个CoTask时才开始执行，执行完后恢复等待它的协程
+coSpawn     在当前线程中启动一个顶层协程，协程结束后自动释放
+coSleep     co_await coSleep(loop, ms)，由loop的定时器恢复
+
+协程总是在创建它的loop线程中执行和恢复，中间不切换线程，所以协程帧从当前线程的CoFramePool分配：
+每个loop线程一个池，不需要加锁，连接上的协程结束后帧留在池里给下一个连接复用。
+*/
+
+#if __cplusplus < 202002L
+#error "Coroutine.h requires -std=c++20"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "noncopyable.h"
+#include "EventLoop.h"
+#include "Logger.h"
+
+// 协程帧的内存池，按64字节分档缓存，只在所属线程中使用
+class CoFramePool : public muduo::noncopyable
+{
+public:
+    static const size_t kAlignment = 64;        // 分档的粒度
+    static const size_t kMaxPooledSize = 4096;  // 超过这个大小的帧直接走operator new
+    static const size_t kMaxCachedPerClass = 1024;
+
+    ~CoFramePool()
+    {
+        for (std::vector<void *> &list : freeLists_)
+            for (void *p : list)
+                ::operator delete(p);
+    }
+
+    // 当前线程的池
+    static CoFramePool &current()
+    {
+        static thread_local CoFramePool pool;
+        return pool;
+    }
+
+    void *allocate(size_t size)
+    {
+        if (size > kMaxPooledSize)
+            return ::operator new(size);
+        std::vector<void *> &list = freeLists_[sizeClass(size)];
+        if (!list.empty())
+        {
+            void *p = list.back();
+            list.pop_back();
+            return p;
+        }
+        return ::operator new((sizeClass(size) + 1) * kAlignment);
+    }
+
+    void deallocate(void *p, size_t size)
+    {
+        if (size <= kMaxPooledSize)
+        {
+            std::vector<void *> &list = freeLists_[sizeClass(size)];
+            if (list.size() < kMaxCachedPerClass)
+            {
+                list.push_back(p);
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+private:
+    static size_t sizeClass(size_t size) { return (size - 1) / kAlignment; }
+
+    std::vector<void *> freeLists_[kMaxPooledSize / kAlignment];
+};
+
+template <typename T>
+class CoTask;
+
+namespace detail
+{
+    struct CoPromiseBase
+    {
+        // 协程结束时恢复等待它的协程；顶层协程没有等待者，结束后自己释放
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+            {
+                CoPromiseBase &promise = h.promise();
+                if (promise.continuation)
+                    return promise.continuation;
+                if (promise.detached)
+                {
+                    if (promise.exception)
+                        LOG_ERROR("coSpawn: coroutine exited with an exception");
+                    h.destroy();
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        static void *operator new(size_t size) { return CoFramePool::current().allocate(size); }
+        static void operator delete(void *p, size_t size) { CoFramePool::current().deallocate(p, size); }
+
+        std::coroutine_handle<> continuation; // co_await这个协程的协程
+        std::exception_ptr exception;
+        bool detached = false; // 由coSpawn启动
+    };
+
+    template <typename T>
+    struct CoPromise : CoPromiseBase
+    {
+        CoTask<T> get_return_object();
+
+        template <typename U>
+        void return_value(U &&v) { value = std::forward<U>(v); }
+
+        T result()
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+            return std::move(value);
+        }
+
+        T value{};
+    };
+
+    template <>
+    struct CoPromise<void> : CoPromiseBase
+    {
+        CoTask<void> get_return_object();
+
+        void return_void() {}
+
+        void result()
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    };
+}
+
+// 协程的返回类型，拥有协程帧
+template <typename T = void>
+class CoTask : public muduo::noncopyable
+{
+public:
+    using promise_type = detail::CoPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit CoTask(Handle h) : handle_(h) {}
+    CoTask(CoTask &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    ~CoTask()
+    {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    // co_await一个CoTask：启动它并在它结束后取回结果，用对称转移直接切换，不经过loop
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            Handle handle;
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+            {
+                handle.promise().continuation = caller;
+                return handle;
+            }
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{handle_};
+    }
+
+    // 交出协程帧的所有权，由coSpawn使用
+    Handle release() { return std::exchange(handle_, nullptr); }
+
+private:
+    Handle handle_;
+};
+
+template <typename T>
+CoTask<T> detail::CoPromise<T>::get_return_object()
+{
+    return CoTask<T>(CoTask<T>::Handle::from_promise(*this));
+}
+
+inline CoTask<void> detail::CoPromise<void>::get_return_object()
+{
+    return CoTask<void>(CoTask<void>::Handle::from_promise(*this));
+}
+
+// 在当前线程中立即启动一个顶层协程，第一次挂起时返回；协程结束后帧自动释放
+inline void coSpawn(CoTask<void> task)
+{
+    CoTask<void>::Handle h = task.release();
+    h.promise().detached = true;
+    h.resume();
+}
+
+// co_await coSleep(loop, ms)：挂起当前协程，ms毫秒后由loop的定时器恢复，必须在loop线程中使用
+inline auto coSleep(EventLoop *loop, double ms)
+{
+    struct Awaiter
+    {
+        EventLoop *loop;
+        double ms;
+        bool await_ready() const noexcept { return ms <= 0; }
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            loop->runAfter(ms / 1000.0, [h]()
+                           { h.resume(); });
+        }
+        void await_resume() noexcept {}
+    };
+    return Awaiter{loop, ms};
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 11:05:47
+ * @LastEditTime: 2026-10-19 11:05:47
+ */
+#ifndef DELEGATE_H
+#define DELEGATE_H
+
+#include <utility>
+
+/*
+Delegate 轻量级回调
+只保存一个对象指针和一个函数指针，成员函数在编译期作为模板参数确定，
+调用时就是一次普通的间接函数调用：不分配堆内存、可以随意拷贝，比std::function + std::bind开销小得多。
+用于Channel这类每个IO事件都要回调一次的热路径。
+
+用法：
+    Delegate<void(TimeStamp)> cb = Delegate<void(TimeStamp)>::fromMethod<TcpConnection, &TcpConnection::handleRead>(this);
+    cb(receiveTime);
+*/
+
+template <typename Signature>
+class Delegate;
+
+template <typename R, typename... Args>
+class Delegate<R(Args...)>
+{
+public:
+    Delegate() : object_(nullptr), stub_(nullptr) {}
+
+    // 绑定对象的成员函数，调用方需要保证object的生命周期长于Delegate
+    template <typename T, R (T::*Method)(Args...)>
+    static Delegate fromMethod(T *object)
+    {
+        return Delegate(object, &methodStub<T, Method>);
+    }
+
+    // 绑定普通函数或静态成员函数
+    template <R (*Function)(Args...)>
+    static Delegate fromFunction()
+    {
+        return Delegate(nullptr, &functionStub<Function>);
+    }
+
+    R operator()(Args... args) const { return stub_(object_, std::forward<Args>(args)...); }
+
+    // 是否绑定了回调
+    explicit operator bool() const { return stub_ != nullptr; }
+
+private:
+    using Stub = R (*)(void *, Args...);
+
+    Delegate(void *object, Stub stub) : object_(object), stub_(stub) {}
+
+    template <typename T, R (T::*Method)(Args...)>
+    static R methodStub(void *object, Args... args)
+    {
+        return (static_cast<T *>(object)->*Method)(std::forward<Args>(args)...);
+    }
+
+    template <R (*Function)(Args...)>
+    static R functionStub(void *, Args... args)
+    {
+        return Function(std::forward<Args>(args)...);
+    }
+
+    void *object_; // 回调所属的对象
+    Stub stub_;    // 负责把object_转换回真实类型并调用成员函数
+};
+
+#endif
@@ -15,15 +15,25 @@
 #include "CurrentThread.h"
 #include "noncopyable.h"
 #include "TimeStamp.h"
+#include "TimerId.h"
+#include "Callbacks.h"
+#include "LoopMetrics.h"
 
 class Channel;
 class Poller;
+class BlockPool;
+class TimerQueue;
 
 // 事件循环类
 class EventLoop : public muduo::noncopyable
 {
 public:
     using Functor = std::function<void()>;
+
+    // 慢回调的处理函数，kind为"event"或"functor"，ms为耗时
+    // event的name为Channel的名字（连接名，没有名字时为fd=N），functor的name为queueInLoop传入的tag，没有tag时为"untagged"
+    using SlowCallbackHandler = std::function<void(const char *kind, const char *name, double ms)>;
+
     EventLoop();
     ~EventLoop();
 
@@ -34,11 +44,25 @@ public:
     TimeStamp poolReturnTime() const { return pollReturnTime_; }
 
     // mainReactor用于唤醒Subreactor的
-    void runInLoop(Functor cb);   // mainReactor用于唤醒Subreactor的
-    void queueInLoop(Functor cb); 
+    // tag用于慢回调报告时说明functor属于谁（通常是连接名），必须在functor执行完之前一直有效：
+    // 字符串常量，或者functor自己持有的对象的名字
+    void runInLoop(Functor cb, const char *tag = nullptr);   // mainReactor用于唤醒Subreactor的
+    void queueInLoop(Functor cb, const char *tag = nullptr);
     
     void wakeup();
 
+    // 在time时刻执行cb，可以跨线程调用
+    TimerId runAt(TimeStamp time, TimerCallback cb);
+
+    // delay秒后执行cb，可以跨线程调用
+    TimerId runAfter(double delay, TimerCallback cb);
+
+    // 每隔interval秒执行一次cb，可以跨线程调用
+    TimerId runEvery(double interval, TimerCallback cb);
+
+    // 取消定时器，可以跨线程调用
+    void cancel(TimerId timerId);
+
     // 更新Channel，在Channel中被调用，Channel将自己加入Loop
     void updateChannel(Channel *channel);
 
@@ -51,9 +75,32 @@ public:
     // 判断当前的eventloop对象是否在自己的线程里面
     bool isInLoopThread() const { return threadId_ == CurrentThread::tid(); }
 
+    // 分配到这个loop上的TcpConnection所使用的内存池
+    const std::shared_ptr<BlockPool> &connectionPool() const { return connectionPool_; }
+
+    // 运行统计，可以在任意线程中无锁读取
+    const LoopMetrics &metrics() const { return metrics_; }
+
+    /**
+     * @description: 打开慢回调检测：单次Channel事件分发或单个pending functor执行超过thresholdMs毫秒时，
+     * 在loop线程中调用handler（默认打一条错误日志）并计入LoopMetrics::slowCallbacks
+     * 打开后每次分发和每个functor多两次clock_gettime；关闭时只多一次判断。在loop()之前或loop线程中调用
+     * @param {double} thresholdMs 阈值，小于等于0时关闭
+     * @param {SlowCallbackHandler} handler 处理函数，为空时使用默认的日志
+     */
+    void setSlowCallbackThreshold(double thresholdMs, SlowCallbackHandler handler = SlowCallbackHandler());
+
 private:
-    void handleRead();        // 处理唤醒相关的逻辑。
+    void handleRead(TimeStamp receiveTime); // 处理唤醒相关的逻辑。
     void doPendingFunctors(); // 执行回调的
+    void reportSlowCallback(const char *kind, const Channel *channel, const char *tag, uint64_t ns); // channel为空表示pending functor
+
+    // 排队的回调和它的tag
+    struct PendingFunctor
+    {
+        Functor functor;
+        const char *tag;
+    };
 
     using ChannelList = std::vector<Channel *>;
     std::atomic<bool> looping_;                // 标志进入loop循环
@@ -62,13 +109,19 @@ private:
     const pid_t threadId_;                     // 当前loop所在的线程的id
     TimeStamp pollReturnTime_;                 // poller返回发生事件时间点
     std::unique_ptr<Poller> poller_;           // 一个EventLoop需要一个poller，这个poller其实就是操控这个EventLoop的对象
+    std::unique_ptr<TimerQueue> timerQueue_;   // 定时器队列，依赖poller_，所以要在poller_之后构造
 
     int wakeupFd_; // 主要作用，当mainLoop获取一个新用户的channel通过轮询算法选择一个subloop(subreactor)来处理channel
     std::unique_ptr<Channel> wakeupChannel_;
     ChannelList activeChannels_;
     Channel *currentActiveChannel_;
-    std::vector<Functor> pendingFunctors_; // 存储loop需要执行的所有回调操作
+    std::vector<PendingFunctor> pendingFunctors_; // 存储loop需要执行的所有回调操作
     std::mutex mutex_;                     // 保护上面vector容器的线程安全操作
+
+    std::shared_ptr<BlockPool> connectionPool_; // 连接对象的内存池，连接可能比loop活得久，所以用shared_ptr
+    LoopMetrics metrics_;
+    uint64_t slowCallbackNs_;                // 慢回调阈值(纳秒)，0表示关闭
+    SlowCallbackHandler slowCallbackHandler_;
 };
 
 #endif
\ No newline at end of file
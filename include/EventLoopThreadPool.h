@@ -7,12 +7,14 @@
 #ifndef EVENTLOOP_THREADPOOL_H
 #define EVENTLOOP_THREADPOOL_H
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <vector>
 #include <memory>
 
 #include "noncopyable.h"
+#include "LoopMetrics.h"
 
 class EventLoop;
 class EventLoopThread;
@@ -30,14 +32,19 @@ public:
     // 轮询算法，获取下一个空闲的loop
     EventLoop *getNextLoop();
     std::vector<EventLoop *> getAllGroups();
-    bool started() const { return started_; }
+
+    // 汇总所有loop的运行统计，可以在任意线程中调用，不会打断各个loop
+    // loops_在start中填写，start返回之前调用只得到全0的统计
+    LoopMetrics::Snapshot metricsSnapshot();
+    // start填完loops_之后才置为true，此后loops_不再修改，其他线程看到true就可以读loops_
+    bool started() const { return started_.load(std::memory_order_acquire); }
     const std::string name() const { return name_; }
 
 private:
     // 如果你没有通过setThreadNum来设置线程数量，那整个网络框架就只有一个线程，这唯一的一个线程就是这个baseLoop_，既要处理新连接，还要处理已连接的事件监听
     EventLoop *baseLoop_;
     std::string name_;
-    bool started_;   // 是否启动
+    std::atomic<bool> started_; // 是否启动
     int numThreads_; // subloop数量
     int next_;       // 轮询游标
     std::vector<std::unique_ptr<EventLoopThread>> threads_;
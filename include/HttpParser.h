@@ -0,0 +1,99 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:06:02
+ * @LastEditTime: 2026-10-19 19:06:02
+ */
+#ifndef HTTP_PARSER_H
+#define HTTP_PARSER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "noncopyable.h"
+#include "HttpRequest.h"
+
+class Buffer;
+
+/*
+HttpParser HTTP/1.x请求的增量解析器
+每个连接一个，数据不完整时记住已经解析到的位置，下次数据到来从断点继续，不会从头重新扫描。
+
+解析过程中不移动inputBuffer_的readerIndex，各个字段只记录相对于peek()的偏移量，
+这样Buffer扩容、搬移数据之后偏移量依然有效；整个请求到齐后才一次性换算成指向Buffer的StringPiece。
+调用方处理完请求后调用consume把它从Buffer中移除，同一个Buffer里后面流水线(pipelining)过来的请求接着解析。
+
+不支持chunked编码的请求体，遇到时返回501。
+*/
+class HttpParser : public muduo::noncopyable
+{
+public:
+    enum Result
+    {
+        kIncomplete, // 数据还不完整，等待更多数据
+        kComplete,   // 得到一个完整的请求，可以通过request()访问
+        kError       // 请求非法，errorCode()是应该回复的状态码
+    };
+
+    static const size_t kMaxHeaderBytes = 64 * 1024;      // 请求行加首部的最大长度
+    static const size_t kMaxBodyBytes = 64 * 1024 * 1024; // 请求体的最大长度
+
+    HttpParser();
+
+    /**
+     * @description: 从buf中继续解析当前请求
+     * @param {Buffer} *buf 连接的接收缓冲区
+     * @param {TimeStamp} receiveTime 收到数据的时间
+     */
+    Result parse(const Buffer *buf, TimeStamp receiveTime);
+
+    // 最近一次parse返回kComplete时解析出的请求，在consume之前有效
+    const HttpRequest &request() const { return request_; }
+
+    // parse返回kError时应该回复的状态码
+    int errorCode() const { return errorCode_; }
+
+    // 从buf中移除已经处理完的请求，并准备解析下一个
+    void consume(Buffer *buf);
+
+private:
+    enum State
+    {
+        kExpectRequestLine,
+        kExpectHeaders,
+        kExpectBody,
+        kGotAll
+    };
+
+    // 相对于Buffer::peek()的一段数据
+    struct Span
+    {
+        uint32_t offset;
+        uint32_t len;
+    };
+
+    struct Field
+    {
+        Span name;
+        Span value;
+    };
+
+    void reset();
+    Result fail(int code);
+    bool parseRequestLine(const char *base, const char *begin, const char *end);
+    bool parseHeaderLine(const char *base, const char *begin, const char *end);
+    bool processHeaders(const char *base);
+    void buildRequest(const char *base, TimeStamp receiveTime);
+
+    State state_;
+    size_t pos_;           // 已经解析到的位置，相对于peek()
+    int errorCode_;        // 出错时的状态码
+    size_t contentLength_; // 请求体长度
+    Span method_;          // 请求方法
+    Span path_;            // 请求路径
+    Span query_;           // 查询参数
+    Span body_;            // 请求体
+    std::vector<Field> fields_;
+    HttpRequest request_;
+};
+
+#endif
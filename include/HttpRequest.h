@@ -0,0 +1,87 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:05:26
+ * @LastEditTime: 2026-10-19 19:05:26
+ */
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <utility>
+#include <vector>
+
+#include "StringPiece.h"
+#include "TimeStamp.h"
+
+/*
+HttpRequest HTTP请求
+所有字段都是指向连接inputBuffer_的StringPiece，由HttpParser填写，不拷贝任何数据，
+只在HttpCallback执行期间有效，需要保留的字段要调用toString()拷贝出来。
+*/
+class HttpRequest
+{
+public:
+    enum Method
+    {
+        kInvalid,
+        kGet,
+        kPost,
+        kHead,
+        kPut,
+        kDelete,
+        kOptions,
+        kPatch
+    };
+
+    enum Version
+    {
+        kUnknown,
+        kHttp10,
+        kHttp11
+    };
+
+    using Header = std::pair<StringPiece, StringPiece>; // 首部字段名和值
+
+    HttpRequest() : method_(kInvalid), version_(kUnknown) {}
+
+    Method method() const { return method_; }
+    StringPiece methodString() const { return methodString_; }
+    Version version() const { return version_; }
+
+    // 请求路径，不包含'?'后面的查询参数，没有做百分号解码
+    StringPiece path() const { return path_; }
+
+    // 查询参数，不包含'?'
+    StringPiece query() const { return query_; }
+
+    StringPiece body() const { return body_; }
+    TimeStamp receiveTime() const { return receiveTime_; }
+
+    // 按收到的顺序排列的全部首部
+    const std::vector<Header> &headers() const { return headers_; }
+
+    /**
+     * @description: 查找首部字段，字段名不区分大小写，没有时返回空的StringPiece
+     * @param {StringPiece} &field 字段名
+     */
+    StringPiece getHeader(const StringPiece &field) const;
+
+    // 逗号分隔的首部（如Connection、Upgrade）中是否包含token，都不区分大小写
+    bool hasHeaderToken(const StringPiece &field, const StringPiece &token) const;
+
+    // 处理完这个请求后是否保持连接：HTTP/1.1默认保持，HTTP/1.0需要显式的Connection: keep-alive
+    bool keepAlive() const;
+
+private:
+    friend class HttpParser;
+
+    Method method_;
+    Version version_;
+    StringPiece methodString_;
+    StringPiece path_;
+    StringPiece query_;
+    StringPiece body_;
+    TimeStamp receiveTime_;
+    std::vector<Header> headers_;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:22:48
+ * @LastEditTime: 2026-10-19 19:22:48
+ */
+#ifndef HTTP_RESPONSE_H
+#define HTTP_RESPONSE_H
+
+#include "noncopyable.h"
+#include "StringPiece.h"
+
+class Buffer;
+
+/*
+HttpResponse HTTP响应构造器
+不先拼出一个完整的响应字符串再send，而是边构造边直接写进连接的outputBuffer_，
+同一批流水线请求的响应在outputBuffer_里首尾相接，最后由HttpServer一次flush发出。
+
+写入顺序必须是：setStatusCode -> addHeader... -> setBody 或 beginChunked/writeChunk.../endChunked，
+状态行在第一次写首部时输出，所以setStatusCode要在addHeader之前调用。
+
+HEAD请求的响应，以及204/304响应，只写首部不写响应体：HEAD照常带上和GET一样的Content-Length，
+204不带Content-Length和Transfer-Encoding；否则keep-alive连接上的客户端会把这些字节当成下一个响应的开头。
+*/
+class HttpResponse : public muduo::noncopyable
+{
+public:
+    enum HttpStatusCode
+    {
+        kUnknown,
+        k101SwitchingProtocols = 101,
+        k200Ok = 200,
+        k204NoContent = 204,
+        k301MovedPermanently = 301,
+        k304NotModified = 304,
+        k400BadRequest = 400,
+        k403Forbidden = 403,
+        k404NotFound = 404,
+        k413PayloadTooLarge = 413,
+        k426UpgradeRequired = 426,
+        k431HeaderFieldsTooLarge = 431,
+        k500InternalServerError = 500,
+        k501NotImplemented = 501,
+        k503ServiceUnavailable = 503,
+        k505VersionNotSupported = 505,
+    };
+
+    /**
+     * @description: HttpResponse构造函数
+     * @param {Buffer} *output 响应写入的缓冲区，一般是TcpConnection::outputBuffer()
+     * @param {bool} closeConnection 响应之后是否关闭连接
+     * @param {bool} headRequest 是否是HEAD请求的响应，是的话不写响应体
+     */
+    HttpResponse(Buffer *output, bool closeConnection, bool headRequest = false);
+
+    // 设置状态码，默认200，必须在写首部之前调用
+    void setStatusCode(int code);
+    int statusCode() const { return statusCode_; }
+
+    // 设置响应之后是否关闭连接，必须在写完首部之前调用
+    void setCloseConnection(bool on) { closeConnection_ = on; }
+    bool closeConnection() const { return closeConnection_; }
+
+    // 写入一个首部字段
+    void addHeader(const StringPiece &field, const StringPiece &value);
+    void setContentType(const StringPiece &contentType) { addHeader("Content-Type", contentType); }
+
+    // 写入Content-Length和完整的响应体，响应结束
+    // 101响应没有响应体，也不带Content-Length，Connection首部写为Upgrade
+    void setBody(const StringPiece &body);
+
+    // 开始chunked编码的响应体，适合事先不知道长度、边生成边写的响应
+    void beginChunked();
+
+    // 写入一个chunk，空数据会被忽略（长度为0的chunk表示结束）
+    void writeChunk(const StringPiece &data);
+
+    // 写入结束chunk，响应结束
+    void endChunked();
+
+    // 响应是否已经完整写入
+    bool finished() const { return state_ == kFinished; }
+
+    // 补全还没有写完的响应：没有响应体的写一个空响应体，chunked的写入结束chunk
+    void finish();
+
+    // 状态码对应的原因短语
+    static const char *statusMessage(int code);
+
+private:
+    enum State
+    {
+        kStatusLine, // 还没写状态行
+        kHeaders,    // 正在写首部
+        kChunked,    // 正在写chunked响应体
+        kFinished    // 响应结束
+    };
+
+    void writeStatusLine();
+    void endHeaders();
+
+    // 是否写出响应体：HEAD请求和204/304响应没有响应体
+    bool bodyAllowed() const { return !headRequest_ && statusCode_ != k204NoContent && statusCode_ != k304NotModified; }
+
+    Buffer *output_;
+    int statusCode_;
+    bool closeConnection_;
+    bool headRequest_;
+    State state_;
+};
+
+#endif
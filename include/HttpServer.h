@@ -0,0 +1,63 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:35:12
+ * @LastEditTime: 2026-10-19 19:35:12
+ */
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <functional>
+#include <string>
+
+#include "noncopyable.h"
+#include "TcpServer.h"
+
+class HttpRequest;
+class HttpResponse;
+
+/*
+HttpServer HTTP/1.1服务器
+每个连接绑定一个HttpParser作为上下文，一次读事件中收到的所有流水线请求依次解析、回调，
+响应按请求的顺序直接写进outputBuffer_，全部处理完后只flush一次，多个响应合并成一次write。
+HTTP/1.1默认保持连接(keep-alive)，请求或响应要求关闭时，发送完响应后关闭连接。
+
+HttpCallback在IO线程中同步执行，需要在回调返回前把响应写完。
+*/
+class HttpServer : public muduo::noncopyable
+{
+public:
+    using HttpCallback = std::function<void(const HttpRequest &, HttpResponse *)>;
+
+    /**
+     * @description: HttpServer构造函数
+     * @param {EventLoop} *loop baseLoop
+     * @param {InetAddress} &listenAddr 监听地址
+     * @param {string} &name 服务器名字
+     * @param {Option} option 是否重用端口
+     */
+    HttpServer(EventLoop *loop,
+               const InetAddress &listenAddr,
+               const std::string &name,
+               TcpServer::Option option = TcpServer::kNoReusePort);
+
+    // 设置处理请求的回调，没有设置时所有请求都返回404
+    void setHttpCallback(const HttpCallback &cb) { httpCallback_ = cb; }
+
+    // 设置底层subloop个数
+    void setThreadNum(int numThreads) { server_.setThreadNum(numThreads); }
+
+    // 设置loop线程初始化的回调
+    void setThreadInitCallback(const TcpServer::ThreadInitCallback &cb) { server_.setThreadInitcallback(cb); }
+
+    // 开启服务器监听
+    void start() { server_.start(); }
+
+private:
+    void onConnection(const TcpConnectionPtr &conn);
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    TcpServer server_;
+    HttpCallback httpCallback_;
+};
+
+#endif
@@ -8,22 +8,36 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <string>
 
-// ipv4地址类
+// socket地址类，内部用sockaddr_storage保存，支持AF_INET、AF_INET6和AF_UNIX
 class InetAddress
 {
 public:
+    // ip中包含':'时按IPv6解析，监听"::"在Linux默认同时接受IPv4和IPv6连接(IPV6_V6ONLY默认关闭)
     explicit InetAddress(uint16_t port = 0, std::string ip = "127.0.0.1");
     explicit InetAddress(const sockaddr_in &addr);
-    std::string toIp() const;
-    std::string toIpPort() const;
-    uint16_t toPort() const;
-    const sockaddr_in *getSockAddr() const { return &addr_; }
-    void setSockAddr(const sockaddr_in &addr) { addr_ = addr; }
+    explicit InetAddress(const sockaddr_in6 &addr);
+    InetAddress(const sockaddr *addr, socklen_t len);
+
+    // Unix域socket地址，path为文件系统路径
+    static InetAddress fromUnixPath(const std::string &path);
+
+    sa_family_t family() const { return addr_.ss_family; }
+    std::string toIp() const;     // IPv4/IPv6返回ip字符串，Unix域返回路径
+    std::string toIpPort() const; // 1.2.3.4:80、[::1]:80 或 unix:/path
+    uint16_t toPort() const;      // Unix域返回0
+
+    const sockaddr *getSockAddr() const { return reinterpret_cast<const sockaddr *>(&addr_); }
+    socklen_t getSockLen() const { return len_; }
+    void setSockAddr(const sockaddr_in &addr);
+    void setSockAddr(const sockaddr *addr, socklen_t len);
 
 private:
-    sockaddr_in addr_;
+    sockaddr_storage addr_;
+    socklen_t len_; // 有效地址长度，bind/connect时使用
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,72 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 18:42:05
+ * @LastEditTime: 2026-10-19 18:42:05
+ */
+#ifndef LENGTH_HEADER_CODEC_H
+#define LENGTH_HEADER_CODEC_H
+
+#include <functional>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "StringPiece.h"
+#include "TimeStamp.h"
+
+/*
+LengthHeaderCodec 长度头编解码器
+每条消息前面是一个4字节、网络字节序的长度头，后面跟len字节的消息体：
++-----------+-----------------+
+| len (4B)  |  payload (len)  |
++-----------+-----------------+
+
+解码：把onMessage设置为TcpServer/TcpClient的MessageCallback，它从inputBuffer_中切出完整的消息，
+消息体以StringPiece的形式直接指向inputBuffer_交给上层，不拷贝；半包留在缓冲区里等下次数据到来。
+编码：消息体先写进Buffer，再用Buffer预留的kCheapPrepend空间就地补上长度头，整个Buffer一次发送。
+*/
+class LengthHeaderCodec : public muduo::noncopyable
+{
+public:
+    // 收到一条完整消息的回调，frame只在回调期间有效，需要保留时调用frame.toString()
+    using FrameCallback = std::function<void(const TcpConnectionPtr &, StringPiece frame, TimeStamp)>;
+
+    static const size_t kHeaderLen = sizeof(int32_t);              // 长度头的字节数
+    static const size_t kDefaultMaxFrameLength = 64 * 1024 * 1024; // 默认的最大消息长度
+
+    /**
+     * @description: LengthHeaderCodec构造函数
+     * @param {FrameCallback} &cb 收到完整消息时的回调
+     * @param {size_t} maxFrameLength 允许的最大消息长度，超过时认为对端出错并关闭连接
+     */
+    explicit LengthHeaderCodec(const FrameCallback &cb, size_t maxFrameLength = kDefaultMaxFrameLength);
+
+    /**
+     * @description: 从buf中切分出所有完整的消息并回调，用作MessageCallback
+     * @param {TcpConnectionPtr} &conn 收到数据的连接
+     * @param {Buffer} *buf 连接的接收缓冲区
+     * @param {TimeStamp} receiveTime 收到数据的时间
+     */
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    /**
+     * @description: 在payload前面就地补上长度头
+     * @param {Buffer} *payload 可读数据为消息体的缓冲区
+     */
+    static void encode(Buffer *payload);
+
+    /**
+     * @description: 发送一条消息，payload会被补上长度头后整体发送并清空
+     * @param {TcpConnectionPtr} &conn 要发送的连接
+     * @param {Buffer} *payload 可读数据为消息体的缓冲区
+     */
+    static void send(const TcpConnectionPtr &conn, Buffer *payload);
+
+    // 发送一条消息，消息体会被拷贝一次到临时Buffer中
+    static void send(const TcpConnectionPtr &conn, const StringPiece &message);
+
+private:
+    FrameCallback frameCallback_;  // 收到完整消息时的回调
+    const size_t maxFrameLength_;  // 最大消息长度
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 09:12:40
+ * @LastEditTime: 2026-10-21 09:12:40
+ */
+#ifndef LOOP_METRICS_H
+#define LOOP_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "noncopyable.h"
+
+/*
+LoopMetrics 一个EventLoop的运行统计
+除了wakeups和pendingDepth，其余计数只由loop线程写：用relaxed的load+store累加，不需要原子的读-改-写，
+任意线程都可以随时用snapshot()无锁读出，不会影响loop线程。
+各个字段分别读出，互相之间不保证是同一时刻的值，用作监控足够了。
+
+一次循环的时间分成三段：阻塞在epoll_wait中、处理活跃Channel的事件、执行doPendingFunctors，
+三者之和接近loop线程的总运行时间，可以看出IO线程有多忙。
+*/
+class LoopMetrics : public muduo::noncopyable
+{
+public:
+    struct Snapshot
+    {
+        Snapshot();
+
+        uint64_t iterations;        // 循环次数
+        uint64_t pollTimeouts;      // epoll_wait超时返回、没有事件的次数
+        uint64_t events;            // 处理的活跃Channel总数，events/iterations即每次poll的平均活跃数
+        uint64_t peakEvents;        // 单次poll最多的活跃Channel数
+        uint64_t pollWaitNs;        // 阻塞在epoll_wait中的时间
+        uint64_t handleEventsNs;    // 处理活跃Channel事件的时间
+        uint64_t pendingFunctorsNs; // 执行doPendingFunctors的时间
+        uint64_t functors;          // 执行的pending functor总数
+        uint64_t pendingDepth;      // 当前排队等待执行的functor数
+        uint64_t peakPendingDepth;  // 一次doPendingFunctors取出的最多functor数
+        uint64_t wakeups;           // 调用wakeup()的次数
+        uint64_t slowCallbacks;     // 超过慢回调阈值的事件分发和functor数（见EventLoop::setSlowCallbackThreshold）
+        uint64_t busyNs;            // 当前这次循环已经执行了多久，阻塞在epoll_wait中时为0
+
+        // 汇总多个loop：计数相加，峰值取最大
+        Snapshot &operator+=(const Snapshot &other);
+    };
+
+    LoopMetrics();
+
+    Snapshot snapshot() const;
+
+    // 下面的记录函数，除了特别说明的，都只能在loop线程中调用
+    void recordPoll(int numEvents, uint64_t waitNs)
+    {
+        add(iterations_, 1);
+        if (numEvents == 0)
+            add(pollTimeouts_, 1);
+        add(events_, numEvents);
+        max(peakEvents_, numEvents);
+        add(pollWaitNs_, waitNs);
+    }
+
+    void recordHandleEvents(uint64_t ns) { add(handleEventsNs_, ns); }
+
+    void recordPendingFunctors(size_t count, uint64_t ns)
+    {
+        add(functors_, count);
+        max(peakPendingDepth_, count);
+        add(pendingFunctorsNs_, ns);
+    }
+
+    // 持有EventLoop::mutex_时调用，所以可以是任意线程
+    void setPendingDepth(size_t depth) { pendingDepth_.store(depth, std::memory_order_relaxed); }
+
+    // 任意线程
+    void recordWakeup() { wakeups_.fetch_add(1, std::memory_order_relaxed); }
+
+    void recordSlowCallback() { add(slowCallbacks_, 1); }
+
+    // poll返回、开始处理事件时传入当前时刻，进入poll之前传入0
+    void setBusySince(uint64_t ns) { busySinceNs_.store(ns, std::memory_order_relaxed); }
+
+    // 当前这次循环开始处理事件的时刻，阻塞在epoll_wait中时为0，可以在任意线程中读取（见LoopWatchdog）
+    uint64_t busySinceNs() const { return busySinceNs_.load(std::memory_order_relaxed); }
+
+    // CLOCK_MONOTONIC，纳秒
+    static uint64_t nowNs();
+
+private:
+    static void add(std::atomic<uint64_t> &counter, uint64_t n)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void max(std::atomic<uint64_t> &counter, uint64_t n)
+    {
+        if (n > counter.load(std::memory_order_relaxed))
+            counter.store(n, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> iterations_;
+    std::atomic<uint64_t> pollTimeouts_;
+    std::atomic<uint64_t> events_;
+    std::atomic<uint64_t> peakEvents_;
+    std::atomic<uint64_t> pollWaitNs_;
+    std::atomic<uint64_t> handleEventsNs_;
+    std::atomic<uint64_t> pendingFunctorsNs_;
+    std::atomic<uint64_t> functors_;
+    std::atomic<uint64_t> pendingDepth_;
+    std::atomic<uint64_t> peakPendingDepth_;
+    std::atomic<uint64_t> wakeups_;
+    std::atomic<uint64_t> slowCallbacks_;
+    std::atomic<uint64_t> busySinceNs_;
+};
+
+#endif
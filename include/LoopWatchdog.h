@@ -0,0 +1,83 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 15:36:12
+ * @LastEditTime: 2026-10-21 15:36:12
+ */
+#ifndef LOOP_WATCHDOG_H
+#define LOOP_WATCHDOG_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "noncopyable.h"
+#include "Thread.h"
+
+class EventLoop;
+class EventLoopThreadPool;
+
+/*
+LoopWatchdog 事件循环卡死检测
+单独的监控线程每隔checkIntervalMs读一次各个loop的LoopMetrics::busySinceNs：loop从poll返回后开始处理事件，
+到下一次进入poll之前，如果超过stallMs还没回到poll，说明某个回调卡住了整个loop，调用StallCallback（默认打错误日志）。
+阻塞在epoll_wait中的空闲loop不算卡住。同一次卡住只报告一次。
+
+监控线程只做原子读，不往loop投递任务，所以卡住的loop不会拖住监控线程。
+找出是哪个回调卡住的，配合EventLoop::setSlowCallbackThreshold：回调返回后会带着连接名报告。
+*/
+class LoopWatchdog : public muduo::noncopyable
+{
+public:
+    // 在监控线程中调用，name为loop的名字，stalledMs为这次循环已经执行的时间
+    using StallCallback = std::function<void(const std::string &name, EventLoop *loop, double stalledMs)>;
+
+    /**
+     * @description: LoopWatchdog构造函数
+     * @param {double} stallMs 一次循环超过多少毫秒算卡住
+     * @param {double} checkIntervalMs 检查间隔，小于等于0时取stallMs/4
+     */
+    explicit LoopWatchdog(double stallMs, double checkIntervalMs = 0);
+    ~LoopWatchdog();
+
+    // 下面的watch和setStallCallback都要在start之前调用
+
+    // 监控单个loop
+    void watch(const std::string &name, EventLoop *loop);
+
+    // 监控线程池中所有loop，必须在线程池start返回之后调用（比如TcpServer::start之后）：
+    // 这里拷贝一次loop列表，监控线程只读这份拷贝，不访问线程池
+    void watch(const std::shared_ptr<EventLoopThreadPool> &pool);
+
+    void setStallCallback(const StallCallback &cb) { stallCallback_ = cb; }
+
+    // 启动/停止监控线程
+    void start();
+    void stop();
+
+    // 已经报告过的卡住次数
+    uint64_t stalls() const { return stalls_; }
+
+private:
+    void threadFunc();
+    void check(const std::string &name, EventLoop *loop, uint64_t now);
+
+    const uint64_t stallNs_;
+    const uint64_t checkIntervalNs_;
+    std::vector<std::pair<std::string, EventLoop *>> loops_; // 被监控的loop和它的名字，start之后不再修改
+    StallCallback stallCallback_;
+    std::unordered_map<EventLoop *, uint64_t> reported_; // 每个loop已经报告过的那次循环的开始时刻，只在监控线程中访问
+    std::atomic<uint64_t> stalls_;
+
+    Thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool running_; // 由mutex_保护
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 19:05:33
+ * @LastEditTime: 2026-10-20 19:05:33
+ */
+#ifndef PHASE_STATS_H
+#define PHASE_STATS_H
+
+#include <stdint.h>
+#include <atomic>
+
+#include "noncopyable.h"
+
+/*
+PhaseStats 连接建立/断开各阶段的CPU时间统计
+在Acceptor::handleRead、TcpServer::newConnection、TcpServer::removeConnectionInLoop、
+TcpConnection::connectDestroyed中各放一个PhaseStats::Scope，用线程CPU时钟记录每个阶段的调用次数和CPU时间，
+用于分析连接风暴下的瓶颈（见benchmark/churn.cpp）。
+
+默认关闭，关闭时每个Scope只多一次relaxed的原子读；打开后每个阶段多两次clock_gettime。
+Acceptor::handleRead中同步调用了TcpServer::newConnection，所以它的时间包含newConnection。
+*/
+namespace PhaseStats
+{
+    enum Phase
+    {
+        kAcceptorHandleRead,
+        kNewConnection,
+        kRemoveConnection,
+        kConnectDestroyed,
+        kNumPhases
+    };
+
+    struct Snapshot
+    {
+        uint64_t calls[kNumPhases]; // 调用次数
+        uint64_t cpuNs[kNumPhases]; // 累计的线程CPU时间(纳秒)
+    };
+
+    // 打开/关闭统计，可以在任意线程中调用
+    void setEnabled(bool on);
+    bool enabled();
+
+    // 读出当前的统计值
+    Snapshot snapshot();
+
+    // 清零
+    void reset();
+
+    const char *phaseName(Phase phase);
+
+    // 当前线程已经消耗的CPU时间(纳秒)
+    uint64_t threadCpuNs();
+
+    // 记录所在作用域的CPU时间
+    class Scope : public muduo::noncopyable
+    {
+    public:
+        explicit Scope(Phase phase) : phase_(phase), start_(enabled() ? threadCpuNs() : 0) {}
+        ~Scope()
+        {
+            if (start_ != 0)
+                record(phase_, threadCpuNs() - start_);
+        }
+
+    private:
+        static void record(Phase phase, uint64_t ns);
+
+        Phase phase_;
+        uint64_t start_; // 0表示没有打开统计
+    };
+}
+
+#endif
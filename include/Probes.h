@@ -0,0 +1,52 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 14:08:51
+ * @LastEditTime: 2026-10-21 14:08:51
+ */
+#ifndef PROBES_H
+#define PROBES_H
+
+/*
+USDT静态探针，供bpftrace/perf等eBPF工具在线上挂载，不需要重新编译就能按阶段测量延迟
+用 -DMYMUDUO_USDT=ON 编译库时打开（需要systemtap的sys/sdt.h），探针编译成一条nop指令和ELF的.note.stapsdt段，
+没有工具挂载时几乎没有开销；不打开时宏展开为空，参数也不会求值，完全没有开销。
+
+provider为mymuduo，探针和参数：
+    poll_return(numEvents, timeoutMs)          EpollPoller::poll中epoll_wait返回
+    handle_event_begin(fd, revents)            Channel::HandlerEvent开始分发
+    handle_event_end(fd, revents)              Channel::HandlerEvent分发结束
+    conn_read(fd, n)                           TcpConnection::handleRead读完，n为read的返回值
+    conn_message_done(fd, remaining)           MessageCallback返回，remaining为接收缓冲区中剩下的字节数
+    conn_write(fd, n, pending)                 TcpConnection::handleWrite写完，pending为还没发出去的字节数
+    conn_send(fd, len, nwrote)                 TcpConnection::sendInLoop，nwrote为直接写进内核的字节数
+    new_connection(sockfd, name)               TcpServer::newConnection创建了连接，name为连接名
+    pending_functors_begin()                   EventLoop::doPendingFunctors开始
+    pending_functors_end(count)                EventLoop::doPendingFunctors结束，count为执行的functor数
+
+例如统计每次事件分发的耗时：
+    bpftrace -e 'usdt:./libMyMuduo.so:mymuduo:handle_event_begin { @s[tid] = nsecs; }
+                 usdt:./libMyMuduo.so:mymuduo:handle_event_end /@s[tid]/ { @us = hist((nsecs - @s[tid]) / 1000); delete(@s[tid]); }'
+*/
+
+#ifdef MYMUDUO_USDT
+
+#include <sys/sdt.h>
+
+#define MYMUDUO_PROBE(name) DTRACE_PROBE(mymuduo, name)
+#define MYMUDUO_PROBE1(name, a1) DTRACE_PROBE1(mymuduo, name, a1)
+#define MYMUDUO_PROBE2(name, a1, a2) DTRACE_PROBE2(mymuduo, name, a1, a2)
+#define MYMUDUO_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(mymuduo, name, a1, a2, a3)
+
+#else
+
+#define MYMUDUO_PROBE(name) \
+    do                      \
+    {                       \
+    } while (0)
+#define MYMUDUO_PROBE1(name, a1) MYMUDUO_PROBE(name)
+#define MYMUDUO_PROBE2(name, a1, a2) MYMUDUO_PROBE(name)
+#define MYMUDUO_PROBE3(name, a1, a2, a3) MYMUDUO_PROBE(name)
+
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 22:40:11
+ * @LastEditTime: 2026-10-19 22:40:11
+ */
+#ifndef RESP_PARSER_H
+#define RESP_PARSER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "StringPiece.h"
+
+class Buffer;
+
+// 一条命令，参数指向连接的inputBuffer_，只在批处理回调期间有效
+class RespCommand
+{
+public:
+    RespCommand(const StringPiece *args, size_t argc) : args_(args), argc_(argc) {}
+
+    size_t size() const { return argc_; }
+    const StringPiece &operator[](size_t i) const { return args_[i]; }
+
+    // 命令名，即第一个参数
+    const StringPiece &name() const { return args_[0]; }
+
+    // 命令名是否等于name，不区分大小写
+    bool is(const char *name) const;
+
+private:
+    const StringPiece *args_;
+    size_t argc_;
+};
+
+/*
+RespParser Redis协议(RESP2/RESP3)请求的增量解析器
+客户端发来的命令在RESP2和RESP3中格式相同：bulk string组成的数组(*N\r\n$len\r\narg\r\n...)，
+另外兼容telnet风格的内联命令(PING\r\n)。
+
+一次parse把Buffer中所有完整的命令解析出来，参数是指向inputBuffer_的StringPiece，不拷贝；
+最后一条不完整的命令记住已经解析过的参数的偏移量，下次数据到来时从断点继续，参数很多的大命令不会被反复扫描。
+处理完这一批命令后调用consume从Buffer中移除它们。
+*/
+class RespParser : public muduo::noncopyable
+{
+public:
+    static const size_t kMaxInlineLength = 64 * 1024;         // 内联命令的最大长度
+    static const size_t kMaxBulkLength = 512 * 1024 * 1024;   // 单个参数的最大长度，和Redis的proto-max-bulk-len一致
+    static const int64_t kMaxMultiBulkLength = 1024 * 1024;   // 单条命令的最大参数个数
+
+    RespParser();
+
+    /**
+     * @description: 解析buf中所有完整的命令
+     * @param {Buffer} *buf 连接的接收缓冲区
+     * @param {vector<RespCommand>} *commands 输出，解析出的命令，在consume之前有效
+     * @return 协议错误时返回false，错误信息见error()
+     */
+    bool parse(const Buffer *buf, std::vector<RespCommand> *commands);
+
+    // 协议错误的描述
+    const std::string &error() const { return error_; }
+
+    // 从buf中移除已经解析出的完整命令
+    void consume(Buffer *buf);
+
+private:
+    // 相对于Buffer::peek()的一段数据
+    struct Span
+    {
+        size_t offset;
+        size_t len;
+    };
+
+    bool fail(const char *message);
+
+    // 解析一个"\r\n"结尾的整数行，prefix之后到"\r\n"之间是数字；数据不完整时返回0，出错返回-1
+    int parseNumberLine(const char *base, const char *end, int64_t *value);
+
+    // 解析内联命令，eol指向行尾的'\n'
+    void parseInline(const char *base, const char *eol);
+
+    // 解析当前命令剩下的参数，返回1表示命令完整，0表示数据不完整，-1表示出错
+    int parseArgs(const char *base, const char *end);
+
+    size_t pos_;                 // 下一个要解析的位置，相对于peek()
+    size_t consumed_;            // 已经解析完的完整命令的总长度
+    int64_t remainingArgs_;      // 当前命令还没解析的参数个数，0表示不在命令中间
+    int64_t bulkLen_;            // 当前参数的长度，-1表示还没解析到$len
+    std::vector<Span> spans_;    // 所有参数的位置，包括不完整命令已经解析出的参数
+    size_t completedArgs_;       // spans_中属于完整命令的参数个数
+    std::vector<size_t> counts_; // 每条完整命令的参数个数
+    std::vector<StringPiece> args_;
+    std::string error_;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 23:10:12
+ * @LastEditTime: 2026-10-19 23:10:12
+ */
+#ifndef RESP_SERVER_H
+#define RESP_SERVER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "TcpServer.h"
+#include "RespParser.h"
+
+class RespWriter;
+
+/*
+RespServer Redis协议服务器
+客户端流水线(pipelining)发来的命令，一次读事件中收到的全部完整命令作为一批交给BatchCallback，
+处理函数可以对整批命令只加一次锁、按分片归类等摊薄开销；每条命令按顺序写一个回复到RespWriter，
+回复直接写进outputBuffer_，整批处理完只flush一次，一次读事件对应一次write。
+
+协议错误时回复错误并关闭连接。HELLO、QUIT等连接级命令由处理函数自己实现（见RespWriter::setProtocol和closeAfterReply）。
+*/
+class RespServer : public muduo::noncopyable
+{
+public:
+    // 处理一批命令，必须为每条命令按顺序写一个回复，commands只在回调期间有效
+    using BatchCallback = std::function<void(const TcpConnectionPtr &, const std::vector<RespCommand> &commands, RespWriter *writer)>;
+
+    RespServer(EventLoop *loop,
+               const InetAddress &listenAddr,
+               const std::string &name,
+               TcpServer::Option option = TcpServer::kNoReusePort);
+
+    void setBatchCallback(const BatchCallback &cb) { batchCallback_ = cb; }
+    void setConnectionCallback(const ConnectionCallback &cb) { connectionCallback_ = cb; }
+    void setThreadNum(int numThreads) { server_.setThreadNum(numThreads); }
+    void setThreadInitCallback(const TcpServer::ThreadInitCallback &cb) { server_.setThreadInitcallback(cb); }
+    void start() { server_.start(); }
+
+private:
+    void onConnection(const TcpConnectionPtr &conn);
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    TcpServer server_;
+    BatchCallback batchCallback_;
+    ConnectionCallback connectionCallback_;
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 22:58:40
+ * @LastEditTime: 2026-10-19 22:58:40
+ */
+#ifndef RESP_WRITER_H
+#define RESP_WRITER_H
+
+#include <stdint.h>
+
+#include "noncopyable.h"
+#include "StringPiece.h"
+
+class Buffer;
+
+/*
+RespWriter Redis协议回复的编码器
+直接把回复写进连接的outputBuffer_，一批命令的回复首尾相接，由RespServer在批处理结束后一次flush。
+
+RESP3新增的类型(null、double、boolean、map、set、push)在协议版本为2时自动退化成RESP2的等价写法，
+比如null写成"$-1"，map写成2N个元素的数组，处理函数不用关心客户端用的是哪个版本。
+*/
+class RespWriter : public muduo::noncopyable
+{
+public:
+    RespWriter(Buffer *output, int protocol) : output_(output), protocol_(protocol), closeConnection_(false) {}
+
+    // 当前连接使用的协议版本，2或3；HELLO命令可以修改，修改对这个连接后续的回复都有效
+    int protocol() const { return protocol_; }
+    void setProtocol(int protocol) { protocol_ = protocol; }
+
+    // 回复完这一批命令后关闭连接，用于QUIT
+    void closeAfterReply() { closeConnection_ = true; }
+    bool closeConnection() const { return closeConnection_; }
+
+    // +OK
+    void writeSimpleString(const StringPiece &str);
+    void writeOk() { writeSimpleString("OK"); }
+
+    // -ERR message，message需要带上错误前缀，如"ERR unknown command"
+    void writeError(const StringPiece &message);
+
+    // :123
+    void writeInteger(int64_t value);
+
+    // $len\r\ndata
+    void writeBulkString(const StringPiece &data);
+
+    // RESP3为"_"，RESP2为"$-1"
+    void writeNull();
+
+    // RESP2中的空数组"*-1"，RESP3中同样写为"_"
+    void writeNullArray();
+
+    // 数组头*N，后面需要再写N个元素
+    void writeArrayHeader(size_t count);
+
+    // RESP3的map头%N，后面写N对key/value；RESP2写成2N个元素的数组
+    void writeMapHeader(size_t count);
+
+    // RESP3的set头~N；RESP2写成数组
+    void writeSetHeader(size_t count);
+
+    // RESP3的push头>N，用于发布订阅的消息；RESP2写成数组
+    void writePushHeader(size_t count);
+
+    // RESP3为",1.5"；RESP2写成bulk string
+    void writeDouble(double value);
+
+    // RESP3为"#t"/"#f"；RESP2写成整数1/0
+    void writeBoolean(bool value);
+
+private:
+    // 写一个类型前缀加整数加CRLF，如"*3\r\n"
+    void writePrefixed(char prefix, int64_t value);
+
+    Buffer *output_;
+    int protocol_;
+    bool closeConnection_;
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:20:41
+ * @LastEditTime: 2026-10-20 09:20:41
+ */
+#ifndef RPC_CHANNEL_H
+#define RPC_CHANNEL_H
+
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "LengthHeaderCodec.h"
+#include "RpcService.h"
+#include "StringPiece.h"
+#include "TimerId.h"
+
+/*
+RpcChannel 一条TcpConnection上的RPC通道
+每条消息都是一个长度头帧(见LengthHeaderCodec)，帧内是固定14字节的RPC头加上消息体：
++-----------+----------------+--------------+----------+------------+-----------+
+| len (4B)  | requestId (8B) | methodId(4B) | type(1B) | status(1B) | payload   |
++-----------+----------------+--------------+----------+------------+-----------+
+
+请求和响应靠requestId对应，所以一条连接上可以同时有任意多个调用在途，响应的顺序不必和请求一致；
+通道是对称的，两端都可以发起调用，也都可以处理对方的调用（各自的RpcService）。
+
+同一次读事件中处理的所有请求，同步应答都写进outputBuffer_，处理完只flush一次；
+每个调用可以带一个超时时间，由loop的定时器驱动，超时、连接断开时回调会收到对应的状态，保证每个调用恰好回调一次。
+
+RpcChannel作为context绑定在TcpConnection上，由RpcServer/RpcClient创建，用RpcChannel::get(conn)取出。
+*/
+class RpcChannel : public muduo::noncopyable, public std::enable_shared_from_this<RpcChannel>
+{
+public:
+    // 调用的结果
+    enum Status
+    {
+        kOk = 0,       // 成功
+        kNoMethod,     // 对端没有注册这个方法
+        kError,        // 对端处理失败，响应内容是错误信息
+        kTimeout,      // 超时，之后到达的响应会被丢弃
+        kDisconnected, // 连接断开
+    };
+
+    // 调用的回调，在loop线程中执行，response只在回调期间有效
+    using ResponseCallback = std::function<void(Status status, const StringPiece &response)>;
+
+    static const size_t kHeaderLen = 14; // RPC头的字节数，不包括长度头
+
+    /**
+     * @description: RpcChannel构造函数，在连接所在的loop线程中创建
+     * @param {TcpConnectionPtr} &conn 所在的连接
+     * @param {shared_ptr<const RpcService>} service 处理对端调用的方法表，可以为空
+     */
+    RpcChannel(const TcpConnectionPtr &conn, std::shared_ptr<const RpcService> service);
+
+    // 取出绑定在连接上的RpcChannel
+    static RpcChannelPtr get(const TcpConnectionPtr &conn);
+
+    /**
+     * @description: 发起一次调用，可以跨线程调用，不在loop线程中时request会被拷贝一次
+     * @param {uint32_t} methodId 方法id
+     * @param {StringPiece} &request 请求内容
+     * @param {ResponseCallback} &cb 收到响应、超时或连接断开时的回调
+     * @param {double} timeout 超时时间(秒)，0表示不超时
+     */
+    void call(uint32_t methodId, const StringPiece &request, const ResponseCallback &cb, double timeout = 0.0);
+
+    // 设置给连接的MessageCallback，转给绑定在连接上的RpcChannel::onMessage
+    static void dispatchMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    // 切分出完整的帧并处理
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    // 连接断开时调用，所有在途的调用以kDisconnected结束
+    void onDisconnected();
+
+    // 还没有收到响应的调用数，只能在loop线程中调用
+    size_t pendingCalls() const { return pending_.size(); }
+
+    EventLoop *getLoop() const { return loop_; }
+
+    static const char *statusName(Status status);
+
+private:
+    friend class RpcReply;
+
+    enum FrameType
+    {
+        kRequest = 0,
+        kResponse = 1,
+    };
+
+    struct PendingCall
+    {
+        ResponseCallback callback;
+        TimerId timer;
+        bool hasTimer;
+    };
+
+    void onFrame(const TcpConnectionPtr &conn, StringPiece frame, TimeStamp receiveTime);
+    void callInLoop(uint32_t methodId, const StringPiece &request, const ResponseCallback &cb, double timeout);
+    void callStringInLoop(uint32_t methodId, const std::string &request, const ResponseCallback &cb, double timeout);
+    void onTimeout(uint64_t requestId);
+
+    // 在loop线程中发送一个响应
+    void sendResponse(uint64_t requestId, Status status, const StringPiece &payload);
+
+    // 把一帧写进outputBuffer_，不在onMessage中时立即flush
+    void writeFrame(uint64_t requestId, uint32_t methodId, FrameType type, Status status, const StringPiece &payload);
+
+    EventLoop *loop_;
+    std::weak_ptr<TcpConnection> conn_;          // 通道是连接的context，这里不能再持有连接
+    std::shared_ptr<const RpcService> service_;  // 方法表
+    LengthHeaderCodec codec_;                    // 切分长度头帧
+    bool dispatching_;                           // 是否正在处理一次读事件，期间的应答只写不flush
+    uint64_t nextRequestId_;                     // 下一个调用的id
+    std::unordered_map<uint64_t, PendingCall> pending_; // 在途的调用
+};
+
+#endif
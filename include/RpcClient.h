@@ -0,0 +1,64 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:52:03
+ * @LastEditTime: 2026-10-20 09:52:03
+ */
+#ifndef RPC_CLIENT_H
+#define RPC_CLIENT_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "noncopyable.h"
+#include "TcpClient.h"
+#include "RpcService.h"
+
+/*
+RpcClient RPC客户端
+在一条TcpClient连接上建立RpcChannel，所有调用复用这一条连接；
+也可以注册方法，处理服务端反向发起的调用。
+*/
+class RpcClient : public muduo::noncopyable
+{
+public:
+    /**
+     * @description: RpcClient构造函数
+     * @param {EventLoop} *loop 连接所在的EventLoop
+     * @param {InetAddress} &serverAddr 服务器地址
+     * @param {string} &name 客户端名字
+     */
+    RpcClient(EventLoop *loop, const InetAddress &serverAddr, const std::string &name);
+
+    // 注册方法，要在connect之前注册完
+    void registerMethod(uint32_t methodId, const RpcService::Method &method,
+                        const RpcService::Executor &executor = RpcService::Executor())
+    {
+        service_->registerMethod(methodId, method, executor);
+    }
+
+    // 设置连接建立/断开的回调，建立时RpcChannel已经绑定好
+    void setConnectionCallback(const ConnectionCallback &cb) { connectionCallback_ = cb; }
+
+    void connect() { client_.connect(); }
+    void disconnect() { client_.disconnect(); }
+    void enableRetry() { client_.enableRetry(); }
+
+    // 当前连接上的RpcChannel，没有连接时为空，可以跨线程调用
+    RpcChannelPtr channel() const
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return channel_;
+    }
+
+private:
+    void onConnection(const TcpConnectionPtr &conn);
+
+    TcpClient client_;
+    std::shared_ptr<RpcService> service_;
+    ConnectionCallback connectionCallback_;
+    mutable std::mutex mutex_;
+    RpcChannelPtr channel_; // 由mutex_保护
+};
+
+#endif
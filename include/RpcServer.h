@@ -0,0 +1,57 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:40:16
+ * @LastEditTime: 2026-10-20 09:40:16
+ */
+#ifndef RPC_SERVER_H
+#define RPC_SERVER_H
+
+#include <memory>
+#include <string>
+
+#include "noncopyable.h"
+#include "TcpServer.h"
+#include "RpcService.h"
+
+/*
+RpcServer RPC服务器
+每个连接建立时创建一个RpcChannel绑定为连接的context，所有连接共享同一个RpcService方法表。
+方法要在start之前注册完；连接回调里可以用RpcChannel::get(conn)拿到通道，向客户端反向发起调用。
+*/
+class RpcServer : public muduo::noncopyable
+{
+public:
+    /**
+     * @description: RpcServer构造函数
+     * @param {EventLoop} *loop baseLoop
+     * @param {InetAddress} &listenAddr 监听地址
+     * @param {string} &name 服务器名字
+     * @param {Option} option 是否重用端口
+     */
+    RpcServer(EventLoop *loop,
+              const InetAddress &listenAddr,
+              const std::string &name,
+              TcpServer::Option option = TcpServer::kNoReusePort);
+
+    // 注册方法，见RpcService::registerMethod
+    void registerMethod(uint32_t methodId, const RpcService::Method &method,
+                        const RpcService::Executor &executor = RpcService::Executor())
+    {
+        service_->registerMethod(methodId, method, executor);
+    }
+
+    // 设置连接建立/断开的回调，建立时RpcChannel已经绑定好
+    void setConnectionCallback(const ConnectionCallback &cb) { connectionCallback_ = cb; }
+    void setThreadNum(int numThreads) { server_.setThreadNum(numThreads); }
+    void setThreadInitCallback(const TcpServer::ThreadInitCallback &cb) { server_.setThreadInitcallback(cb); }
+    void start() { server_.start(); }
+
+private:
+    void onConnection(const TcpConnectionPtr &conn);
+
+    TcpServer server_;
+    std::shared_ptr<RpcService> service_;
+    ConnectionCallback connectionCallback_;
+};
+
+#endif
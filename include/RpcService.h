@@ -0,0 +1,82 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:12:20
+ * @LastEditTime: 2026-10-20 09:12:20
+ */
+#ifndef RPC_SERVICE_H
+#define RPC_SERVICE_H
+
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include "noncopyable.h"
+#include "StringPiece.h"
+
+class EventLoop;
+class RpcChannel;
+using RpcChannelPtr = std::shared_ptr<RpcChannel>;
+
+// 一次调用的应答句柄，可以拷贝、保存下来稍后应答，也可以在任意线程中应答
+// 每次调用必须恰好应答一次（reply或fail）
+class RpcReply
+{
+public:
+    RpcReply(const std::weak_ptr<RpcChannel> &channel, EventLoop *loop, uint64_t requestId)
+        : channel_(channel), loop_(loop), requestId_(requestId) {}
+
+    // 返回调用结果，payload会被写进发送缓冲区，不在loop线程中时先拷贝一份再转交给loop线程
+    void reply(const StringPiece &payload) const;
+
+    // 返回处理失败，调用方收到RpcChannel::kError，message作为响应内容
+    void fail(const StringPiece &message) const;
+
+    // 调用所在的RpcChannel，连接已经销毁时为空，只能在loop线程中使用
+    RpcChannelPtr channel() const { return channel_.lock(); }
+
+    uint64_t requestId() const { return requestId_; }
+
+private:
+    void respond(int status, const StringPiece &payload) const;
+
+    std::weak_ptr<RpcChannel> channel_; // 不延长连接的生命周期，连接断开后应答直接丢弃
+    EventLoop *loop_;                   // 连接所在的loop
+    uint64_t requestId_;                // 对应请求的id
+};
+
+/*
+RpcService 方法表
+方法按32位的methodId注册，同一个RpcService可以被多个连接共享，所以必须在start之前注册完，之后只读。
+
+方法默认在IO线程中同步执行，request只在调用期间有效；
+注册时给了Executor的方法，请求会先拷贝一份，再交给Executor在别的线程中执行（比如线程池），
+CPU密集的方法不会卡住同一个loop上的其他连接，处理完调用RpcReply::reply，结果会被转交回loop线程发送。
+*/
+class RpcService : public muduo::noncopyable
+{
+public:
+    using Method = std::function<void(const StringPiece &request, const RpcReply &reply)>;
+    using Executor = std::function<void(std::function<void()>)>;
+
+    /**
+     * @description: 注册一个方法，methodId重复时覆盖之前的方法
+     * @param {uint32_t} methodId 方法id
+     * @param {Method} &method 处理函数
+     * @param {Executor} &executor 执行处理函数的地方，为空时在IO线程中直接执行
+     */
+    void registerMethod(uint32_t methodId, const Method &method, const Executor &executor = Executor());
+
+    // 收到一个请求，找不到方法时返回false
+    bool dispatch(uint32_t methodId, const StringPiece &request, const RpcReply &reply) const;
+
+private:
+    struct Entry
+    {
+        Method method;
+        Executor executor;
+    };
+    std::unordered_map<uint32_t, Entry> methods_;
+};
+
+#endif
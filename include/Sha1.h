@@ -0,0 +1,31 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:02:14
+ * @LastEditTime: 2026-10-19 21:02:14
+ */
+#ifndef SHA1_H
+#define SHA1_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+Sha1 SHA-1摘要(RFC 3174)
+只用于WebSocket握手计算Sec-WebSocket-Accept，不要用在任何和安全相关的地方。
+*/
+namespace Sha1
+{
+
+    const size_t kDigestLength = 20; // 摘要的字节数
+
+    /**
+     * @description: 计算一段数据的SHA-1摘要
+     * @param {void} *data 数据
+     * @param {size_t} len 数据长度
+     * @param {uint8_t} *digest 输出，kDigestLength字节
+     */
+    void digest(const void *data, size_t len, uint8_t *digest);
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 22:05:16
+ * @LastEditTime: 2026-10-19 22:05:16
+ */
+#ifndef SHARED_PAYLOAD_H
+#define SHARED_PAYLOAD_H
+
+#include <memory>
+#include <string>
+
+/*
+SharedPayload 引用计数的不可变数据
+拷贝SharedPayload只增加引用计数，不拷贝数据。广播时同一条消息只保存一份，
+每个连接的发送链(TcpConnection的outputChain_)里排队的是它的引用，全部发送完后数据自动释放。
+数据一旦创建就不能再修改，所以可以被多个IO线程同时读取。
+*/
+class SharedPayload
+{
+public:
+    SharedPayload() {}
+
+    // 接管一个字符串，没有拷贝
+    explicit SharedPayload(std::string &&data) : data_(std::make_shared<const std::string>(std::move(data))) {}
+
+    // 拷贝一份数据
+    SharedPayload(const void *data, size_t len)
+        : data_(std::make_shared<const std::string>(static_cast<const char *>(data), len)) {}
+
+    const char *data() const { return data_ ? data_->data() : nullptr; }
+    size_t size() const { return data_ ? data_->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    // 当前的引用数量，用于调试和测试
+    long useCount() const { return data_.use_count(); }
+
+private:
+    std::shared_ptr<const std::string> data_;
+};
+
+#endif
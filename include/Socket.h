@@ -29,6 +29,9 @@ public:
     void setReusePort(bool on);  // 重用端口
     void setKeepAlive(bool on);  // 发送周期性保活报文以维持连接
 
+    static InetAddress getLocalAddr(int sockfd); // 调用getsockname获取本端地址
+    static InetAddress getPeerAddr(int sockfd);  // 调用getpeername获取对端地址
+
 private:
     const int sockfd_;
 };
@@ -0,0 +1,82 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 11:20:36
+ * @LastEditTime: 2026-10-21 11:20:36
+ */
+#ifndef STATS_SERVER_H
+#define STATS_SERVER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "HttpServer.h"
+
+class EventLoop;
+class EventLoopThreadPool;
+class TcpServer;
+
+/*
+StatsServer 内嵌的Prometheus指标服务
+在baseLoop上开一个HttpServer（不另开IO线程），GET /metrics 返回Prometheus文本格式：
+    mymuduo_loop_*        每个loop的LoopMetrics，标签loop="线程池名-序号"
+    mymuduo_server_*      每个TcpServer当前打开的连接的ConnectionStats汇总，标签server="服务器名"
+    mymuduo_connection_*  发送缓冲区峰值最大的若干条连接（见setTopConnections），默认不输出
+
+抓取时各个loop和连接的统计都是无锁读出的，不会往IO线程投递任务、也不会让它们停下来等待，
+抓取的开销全部落在baseLoop上。连接表只能在TcpServer的baseLoop中遍历，所以addServer的服务器必须和StatsServer用同一个loop。
+
+    StatsServer stats(&loop, InetAddress(9100));
+    stats.addServer(&server);
+    stats.start();
+*/
+class StatsServer : public muduo::noncopyable
+{
+public:
+    /**
+     * @description: StatsServer构造函数
+     * @param {EventLoop} *loop baseLoop，抓取请求在这个loop中处理
+     * @param {InetAddress} &listenAddr 监听地址
+     * @param {string} &name 服务器名字
+     */
+    StatsServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &name = "StatsServer");
+
+    // 下面的add*都要在start之前调用
+
+    // 导出单个loop的统计
+    void addLoop(const std::string &name, EventLoop *loop);
+
+    // 导出线程池中所有loop的统计，抓取时才枚举，线程池可以晚于StatsServer启动
+    void addThreadPool(const std::shared_ptr<EventLoopThreadPool> &pool);
+
+    // 导出服务器的连接统计和它的线程池中所有loop的统计，服务器的baseLoop必须和StatsServer相同
+    void addServer(TcpServer *server);
+
+    // 按待发送字节数的峰值，逐条导出最大的n条连接，默认为0
+    void setTopConnections(size_t n) { topConnections_ = n; }
+
+    // 开启监听
+    void start() { server_.start(); }
+
+    // 生成一次完整的指标文本，只能在loop线程中调用
+    std::string render();
+
+private:
+    struct LoopSource
+    {
+        std::string name;
+        EventLoop *loop;                            // 单个loop
+        std::shared_ptr<EventLoopThreadPool> pool;  // 或者一个线程池
+    };
+
+    void onRequest(const HttpRequest &request, HttpResponse *response);
+
+    EventLoop *loop_;
+    HttpServer server_;
+    std::vector<LoopSource> loops_;
+    std::vector<TcpServer *> servers_;
+    size_t topConnections_;
+};
+
+#endif
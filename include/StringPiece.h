@@ -0,0 +1,79 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 18:30:12
+ * @LastEditTime: 2026-10-19 18:30:12
+ */
+#ifndef STRING_PIECE_H
+#define STRING_PIECE_H
+
+#include <string.h>
+#include <string>
+
+/*
+StringPiece 字符串视图
+只保存指针和长度，不拥有内存，用于把Buffer中的一段数据交给上层而不拷贝。
+指向Buffer时只在Buffer被retrieve或扩容之前有效。
+*/
+class StringPiece
+{
+public:
+    StringPiece() : ptr_(nullptr), length_(0) {}
+    StringPiece(const char *str) : ptr_(str), length_(str ? strlen(str) : 0) {}
+    StringPiece(const std::string &str) : ptr_(str.data()), length_(str.size()) {}
+    StringPiece(const char *offset, size_t len) : ptr_(offset), length_(len) {}
+
+    const char *data() const { return ptr_; }
+    size_t size() const { return length_; }
+    bool empty() const { return length_ == 0; }
+    const char *begin() const { return ptr_; }
+    const char *end() const { return ptr_ + length_; }
+    char operator[](size_t i) const { return ptr_[i]; }
+
+    void clear()
+    {
+        ptr_ = nullptr;
+        length_ = 0;
+    }
+
+    // 去掉开头的n个字符
+    void removePrefix(size_t n)
+    {
+        ptr_ += n;
+        length_ -= n;
+    }
+
+    // 去掉结尾的n个字符
+    void removeSuffix(size_t n) { length_ -= n; }
+
+    // 是否以x开头
+    bool startsWith(const StringPiece &x) const
+    {
+        return length_ >= x.length_ && memcmp(ptr_, x.ptr_, x.length_) == 0;
+    }
+
+    int compare(const StringPiece &x) const
+    {
+        int r = memcmp(ptr_, x.ptr_, length_ < x.length_ ? length_ : x.length_);
+        if (r == 0)
+        {
+            if (length_ < x.length_)
+                r = -1;
+            else if (length_ > x.length_)
+                r = +1;
+        }
+        return r;
+    }
+
+    // 拷贝出一个std::string
+    std::string toString() const { return std::string(ptr_, length_); }
+
+    bool operator==(const StringPiece &x) const { return length_ == x.length_ && memcmp(ptr_, x.ptr_, length_) == 0; }
+    bool operator!=(const StringPiece &x) const { return !(*this == x); }
+    bool operator<(const StringPiece &x) const { return compare(x) < 0; }
+
+private:
+    const char *ptr_;
+    size_t length_;
+};
+
+#endif
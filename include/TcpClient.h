@@ -0,0 +1,89 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 14:40:13
+ * @LastEditTime: 2026-10-19 14:40:13
+ */
+#ifndef TCP_CLIENT_H
+#define TCP_CLIENT_H
+
+#include <mutex>
+#include <string>
+#include <memory>
+#include <atomic>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "InetAddress.h"
+
+class EventLoop;
+class Connector;
+using ConnectorPtr = std::shared_ptr<Connector>;
+
+// TCP客户端类，一个TcpClient管理一条到服务器的连接
+// 连接建立后和服务端一样使用TcpConnection收发数据，可以和TcpServer共用同一批EventLoop线程
+class TcpClient : public muduo::noncopyable
+{
+public:
+    /**
+     * @description: TcpClient构造函数
+     * @param {EventLoop} *loop 处理这条连接的EventLoop
+     * @param {InetAddress} &serverAddr 服务器地址
+     * @param {string} &nameArg 客户端名字
+     */
+    TcpClient(EventLoop *loop, const InetAddress &serverAddr, const std::string &nameArg);
+    ~TcpClient();
+
+    // 发起连接
+    void connect();
+
+    // 关闭连接(等待发送缓冲区的数据发完)
+    void disconnect();
+
+    // 停止连接，正在重连的也不再重连
+    void stop();
+
+    // 返回当前的连接，可能为空
+    TcpConnectionPtr connection() const
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return connection_;
+    }
+
+    EventLoop *getLoop() const { return loop_; }
+
+    // 连接断开后是否自动重连
+    bool retry() const { return retry_; }
+    void enableRetry() { retry_ = true; }
+
+    const std::string &name() const { return name_; }
+
+    // 设置连接建立/断开的回调
+    void setConnectionCallback(const ConnectionCallback &cb) { connectionCallback_ = cb; }
+
+    // 设置有读写消息时的回调
+    void setMessageCallback(const MessageCallback &cb) { messageCallback_ = cb; }
+
+    // 设置消息发送完成的回调
+    void setWriteCompleteCallback(const WriteCompleteCallback &cb) { writeCompleteCallback_ = cb; }
+
+private:
+    // Connector连接成功后的回调，在loop线程中执行
+    void newConnection(int sockfd);
+
+    // 连接断开，在loop线程中执行
+    void removeConnection(const TcpConnectionPtr &conn);
+
+    EventLoop *loop_;
+    ConnectorPtr connector_;
+    const std::string name_;
+    ConnectionCallback connectionCallback_;
+    MessageCallback messageCallback_;
+    WriteCompleteCallback writeCompleteCallback_;
+    std::atomic<bool> retry_;   // 连接断开后是否重连
+    std::atomic<bool> connect_; // 用户是否希望连接
+    int nextConnId_;            // 只在loop线程中使用
+    mutable std::mutex mutex_;
+    TcpConnectionPtr connection_; // 由mutex_保护
+};
+
+#endif
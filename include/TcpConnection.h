@@ -9,16 +9,19 @@
 #include <memory>
 #include <string>
 #include <atomic>
+#include <deque>
 
 #include "noncopyable.h"
 #include "Callbacks.h"
 #include "TimeStamp.h"
 #include "Buffer.h"
 #include "InetAddress.h"
+#include "Socket.h"
+#include "Channel.h"
+#include "SharedPayload.h"
+#include "ConnectionStats.h"
 
-class Channel;
 class EventLoop;
-class Socket;
 
 /**
 1. 为什么要用enable_shared_from_this?
@@ -65,13 +68,47 @@ public:
 
     // 向连接写数据
     void send(const std::string &buf);
+    void send(const void *data, size_t len);
+
+    // 发送一份共享的数据，不拷贝：发不完的部分以引用的形式排在发送链上，用于广播
+    void send(const SharedPayload &payload);
+
+    // 发送buf中的全部可读数据并清空buf，在IO线程中调用时没有额外的拷贝
+    // 配合Buffer::prependInt32可以就地补上消息头后一次发出
+    void send(Buffer *buf);
+
+    // 发送缓冲区，只能在IO线程中使用：协议层可以把响应直接写进来，写完后调用flush发送，省去一次拷贝
+    // 发送链上还有数据时，outputBuffer_中的数据排在发送链之后发送
+    Buffer *outputBuffer() { return &outputBuffer_; }
+
+    // 把发送缓冲区中积累的数据发出去，只能在IO线程中调用
+    void flush();
+
+    // 接收缓冲区，只能在IO线程中使用：不通过MessageCallback、按需从中取数据时使用（见CoConnection）
+    Buffer *inputBuffer() { return &inputBuffer_; }
+
+    // 待发送的总字节数：发送链加上outputBuffer_，只能在IO线程中调用
+    size_t pendingBytes() const { return chainBytes_ + outputBuffer_.readableBytes(); }
+
+    // 读写统计，可以在任意线程中无锁读取
+    const ConnectionStats &stats() const { return stats_; }
 
     // 关闭连接
     void shutdown();
 
+    // 强制关闭连接，不等待发送缓冲区的数据发送完毕
+    void forceClose();
+
     // 返回连接名字
     const std::string &name() const { return name_; }
 
+    // 是否禁用Nagle算法
+    void setTcpNoDelay(bool on) { socket_.setTcpNoDelay(on); }
+
+    // 绑定协议层的解析状态等上下文，生命周期和连接相同
+    void setContext(const std::shared_ptr<void> &context) { context_ = context; }
+    const std::shared_ptr<void> &getContext() const { return context_; }
+
     // 设置连接成功回调
     void setConnectionCallback(const ConnectionCallback &cb) { connectionCallback_ = cb; }
 
@@ -115,7 +152,13 @@ private:
     void handleError();
 
     void sendInLoop(const void *message, size_t len);
+    void sendStringInLoop(const std::string &message);
+    void sendPayloadInLoop(const SharedPayload &payload);
+
+    // 发送链非空时，用writev把发送链和outputBuffer_一起写出去，返回write的结果
+    ssize_t writeChain(int *savedErrno);
     void shutdownInLoop();
+    void forceCloseInLoop();
 
 private:
     EventLoop *loop_;        // 这里绝对不是baseLoop，因为TcpConnection都是在subLoop里面管理的
@@ -123,8 +166,9 @@ private:
     std::atomic<int> state_; // 连接状态
     bool reading_;
 
-    std::unique_ptr<Socket> socket_;   // 连接句柄
-    std::unique_ptr<Channel> channel_; // 连接对应的Channel
+    // Socket和Channel直接内嵌在对象里，和TcpConnection共用一次内存分配（见TcpServer::newConnection）
+    Socket socket_;   // 连接句柄
+    Channel channel_; // 连接对应的Channel
 
     const InetAddress localAddr_; // 本地地址
     const InetAddress peerAddr_;  // 连接地址
@@ -137,6 +181,17 @@ private:
     size_t highWaterMark_;                        // 水位线
     Buffer inputBuffer_;                          // 接收的缓冲区
     Buffer outputBuffer_;                         // 发送的缓冲区
+
+    // 发送链：排队中的共享数据，发送顺序是 发送链 -> outputBuffer_
+    struct ChainEntry
+    {
+        SharedPayload payload;
+        size_t offset; // 已经发送的字节数
+    };
+    std::deque<ChainEntry> outputChain_;
+    size_t chainBytes_; // 发送链上还没发送的字节数
+    std::shared_ptr<void> context_;               // 协议层的上下文
+    ConnectionStats stats_;                       // 读写统计
 };
 
 #endif
\ No newline at end of file
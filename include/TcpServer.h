@@ -19,6 +19,10 @@
 #include <atomic>
 #include <memory>
 #include <unordered_map>
+#include <vector>
+
+#include "SharedPayload.h"
+#include "ConnectionStats.h"
 
 // TCP服务器类
 class TcpServer : public muduo::noncopyable
@@ -65,6 +69,36 @@ public:
     // 开启服务器监听
     void start();
 
+    // 返回服务器名字
+    const std::string &name() const { return name_; }
+
+    // 返回baseLoop
+    EventLoop *getLoop() const { return loop_; }
+
+    // 底层的loop线程池，可以用来汇总各个loop的运行统计
+    const std::shared_ptr<EventLoopThreadPool> &threadPool() const { return threadPool_; }
+
+    /**
+     * @description: 向一组连接发送同一份数据，可以在任意线程调用
+     * 连接按所属的EventLoop分组，每个loop只投递一个任务，任务里把payload的引用挂到各个连接的发送链上，数据本身不拷贝
+     * @param {vector<TcpConnectionPtr>} &conns 目标连接
+     * @param {SharedPayload} &payload 要发送的数据
+     */
+    static void broadcast(const std::vector<TcpConnectionPtr> &conns, const SharedPayload &payload);
+
+    // 向本服务器的所有连接发送同一份数据，可以在任意线程调用
+    void broadcast(const SharedPayload &payload);
+
+    using ConnectionStatsList = std::vector<ConnectionStats::Snapshot>;
+    using ConnectionStatsCallback = std::function<void(const ConnectionStatsList &)>;
+
+    /**
+     * @description: 读出当前所有连接的读写统计，可以在任意线程调用
+     * 在baseLoop中遍历连接表，各连接的统计无锁读出，不需要打扰IO线程；在baseLoop线程中调用时cb同步执行
+     * @param {ConnectionStatsCallback} &cb 在baseLoop中执行，参数是每条连接一项的快照
+     */
+    void collectConnectionStats(const ConnectionStatsCallback &cb);
+
 private:
     // 处理新连接到来
     void newConnection(int sockfd, const InetAddress &peerAddr);
@@ -75,6 +109,11 @@ private:
     // 移除连接，不直接使用，被removeConnection函数内部调用
     void removeConnectionInLoop(const TcpConnectionPtr &conn);
 
+    // 在baseLoop中收集所有连接后广播
+    void broadcastInLoop(const SharedPayload &payload);
+
+    void collectConnectionStatsInLoop(const ConnectionStatsCallback &cb);
+
 private:
     using ConnectionMap = std::unordered_map<std::string, TcpConnectionPtr>;
     EventLoop *loop_;                                 // baseLoop，用户自己定义的
@@ -0,0 +1,241 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 11:10:52
+ * @LastEditTime: 2026-10-20 11:10:52
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "EventLoop.h"
+#include "TcpConnection.h"
+#include "UniqueFunction.h"
+
+class Thread;
+
+/*
+ThreadPool 有界的工作窃取线程池
+MessageCallback在IO线程中执行，CPU密集的请求会卡住同一个loop上的所有连接，这类工作交给ThreadPool：
+    pool.offload(conn, work, done);
+work在工作线程中执行，返回的结果移动到连接所在的loop线程里交给done(conn, result)，
+不需要加锁也不需要再跨线程，结果可以是std::unique_ptr这类只能移动的类型。
+
+每个工作线程有自己的任务队列：外部线程提交的任务轮流放进各个队列，工作线程中提交的任务放进自己的队列；
+工作线程从自己队列的头部取任务，自己的空了就从其他队列的尾部窃取，一个长任务不会让同一队列后面的任务一直等着。
+
+所有队列中的任务总数不超过maxQueueSize，满了之后按RejectPolicy处理，避免请求无限堆积把内存耗尽。
+*/
+class ThreadPool : public muduo::noncopyable
+{
+public:
+    using Task = UniqueFunction<void()>;
+
+    // 队列满时的处理方式
+    enum RejectPolicy
+    {
+        kReject,     // 直接拒绝，submit返回false
+        kCallerRuns, // 在提交的线程中直接执行，IO线程被拖慢，相当于对客户端施加背压
+        kBlock,      // 阻塞等待队列有空位，不要在IO线程中使用
+    };
+
+    // 运行状态，各项分别原子读取，不是同一时刻的精确快照
+    struct Stats
+    {
+        size_t queued;       // 当前排队的任务数
+        size_t peakQueued;   // 排队任务数的峰值
+        uint64_t submitted;  // 进入队列的任务数
+        uint64_t completed;  // 执行完的任务数
+        uint64_t rejected;   // 被拒绝的任务数
+        uint64_t callerRuns; // 在提交线程中直接执行的任务数
+        uint64_t stolen;     // 从其他工作线程的队列中窃取的任务数
+    };
+
+    static const size_t kDefaultMaxQueueSize = 65536;
+
+    explicit ThreadPool(const std::string &name = std::string("ThreadPool"));
+
+    // 析构时停止线程池，已经排队的任务会执行完
+    ~ThreadPool();
+
+    // 以下设置需要在start之前调用
+    void setMaxQueueSize(size_t maxSize) { maxQueueSize_ = maxSize; }
+    void setRejectPolicy(RejectPolicy policy) { rejectPolicy_ = policy; }
+
+    // 启动numThreads个工作线程
+    void start(int numThreads);
+
+    // 停止接收新任务，等已经排队的任务执行完后退出所有工作线程；重复调用没有影响，停止后可以再次start
+    void stop();
+
+    /**
+     * @description: 提交一个任务，可以在任意线程中调用
+     * @param {Task} task 任务
+     * @return {bool} 任务被拒绝（队列满且策略为kReject，或者线程池已停止）时返回false
+     */
+    bool submit(Task task);
+
+    /**
+     * @description: 在工作线程中执行work，结果交回loop线程调用done(result)
+     * @param {EventLoop} *loop 执行done的loop
+     * @param {Work} work 返回结果的函数对象，结果类型不能是void
+     * @param {Done} done 接收结果的函数对象，可以只能移动
+     * @return {bool} 任务被拒绝时返回false，done不会被调用
+     */
+    template <typename Work, typename Done>
+    bool offload(EventLoop *loop, Work work, Done done);
+
+    /**
+     * @description: 在工作线程中执行work，结果交回conn所在的loop线程调用done(conn, result)
+     * 工作线程中只持有连接的weak_ptr，连接在work执行期间销毁时done不会被调用
+     * @param {TcpConnectionPtr} &conn 发起请求的连接
+     * @param {Work} work 返回结果的函数对象，结果类型不能是void
+     * @param {Done} done 接收结果的函数对象，可以只能移动
+     * @return {bool} 任务被拒绝时返回false，done不会被调用
+     */
+    template <typename Work, typename Done>
+    bool offload(const TcpConnectionPtr &conn, Work work, Done done);
+
+    Stats stats() const;
+
+    // 当前排队的任务数
+    size_t queueSize() const { return queued_.load(std::memory_order_relaxed); }
+
+    const std::string &name() const { return name_; }
+
+private:
+    // 一个工作线程和它的任务队列
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::unique_ptr<Thread> thread;
+    };
+
+    void workerThread(size_t index);
+
+    // 从自己的队列头部取任务，没有就从其他队列尾部窃取
+    bool takeTask(size_t index, Task *task);
+
+    // 占一个队列名额，队列满时按策略处理；返回false表示没有占到
+    bool reserveSlot(Task *task);
+
+    void push(Task task);
+
+    // tag为结果交回loop线程时的慢回调标记（见EventLoop::queueInLoop），offload连接时为连接名
+    template <typename Work, typename Done>
+    bool offloadTagged(EventLoop *loop, Work work, Done done, std::string tag);
+
+    const std::string name_;
+    size_t maxQueueSize_;
+    RejectPolicy rejectPolicy_;
+    std::atomic<bool> running_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t> nextWorker_; // 外部线程提交时轮流选择队列
+
+    std::atomic<size_t> queued_;     // 所有队列中的任务数（包括已占名额、正在放入的）
+    std::atomic<size_t> peakQueued_;
+    std::atomic<uint64_t> submitted_;
+    std::atomic<uint64_t> completed_;
+    std::atomic<uint64_t> rejected_;
+    std::atomic<uint64_t> callerRuns_;
+    std::atomic<uint64_t> stolen_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable notEmpty_; // 工作线程等待任务
+    std::condition_variable notFull_;  // kBlock策略下提交线程等待空位
+    std::atomic<int> idleWorkers_;     // 正在等待任务的工作线程数，为0时提交不需要notify
+    std::atomic<int> blockedSubmitters_;
+};
+
+namespace detail
+{
+    // offload的共享状态：work、done和结果放在一起，loop线程里的回调只需要拷贝一个shared_ptr
+    template <typename Work, typename Done>
+    struct OffloadState
+    {
+        using Result = typename std::result_of<Work()>::type;
+        static_assert(!std::is_void<Result>::value, "ThreadPool::offload work must return a value");
+
+        OffloadState(Work &&w, Done &&d, std::string &&t) : work(std::move(w)), done(std::move(d)), tag(std::move(t)) {}
+
+        Work work;
+        Done done;
+        std::string tag; // 交给queueInLoop的tag，和state一起活到done执行完
+        std::unique_ptr<Result> result;
+    };
+
+    // 在loop线程中把结果交给done
+    template <typename State>
+    struct OffloadDeliver
+    {
+        std::shared_ptr<State> state;
+        void operator()() { state->done(std::move(*state->result)); }
+    };
+
+    // 在工作线程中执行work，再把结果转交给loop线程
+    template <typename State>
+    struct OffloadRun
+    {
+        EventLoop *loop;
+        std::shared_ptr<State> state;
+        void operator()()
+        {
+            typedef typename State::Result Result;
+            state->result.reset(new Result(state->work()));
+            // 把唯一的引用移动给loop线程，done和结果都在loop线程中析构
+            const char *tag = state->tag.c_str();
+            OffloadDeliver<State> deliver = {std::move(state)};
+            loop->queueInLoop(std::move(deliver), tag);
+        }
+    };
+
+    // 结果交回loop线程时连接还在才调用done
+    template <typename Done>
+    struct ConnectionDone
+    {
+        std::weak_ptr<TcpConnection> conn;
+        Done done;
+
+        template <typename Result>
+        void operator()(Result &&result)
+        {
+            TcpConnectionPtr guard = conn.lock();
+            if (guard)
+                done(guard, std::forward<Result>(result));
+        }
+    };
+}
+
+template <typename Work, typename Done>
+bool ThreadPool::offload(EventLoop *loop, Work work, Done done)
+{
+    return offloadTagged(loop, std::move(work), std::move(done), name_);
+}
+
+template <typename Work, typename Done>
+bool ThreadPool::offload(const TcpConnectionPtr &conn, Work work, Done done)
+{
+    detail::ConnectionDone<Done> connectionDone = {conn, std::move(done)};
+    return offloadTagged(conn->getLoop(), std::move(work), std::move(connectionDone), conn->name());
+}
+
+template <typename Work, typename Done>
+bool ThreadPool::offloadTagged(EventLoop *loop, Work work, Done done, std::string tag)
+{
+    typedef detail::OffloadState<Work, Done> State;
+    detail::OffloadRun<State> run = {loop, std::make_shared<State>(std::move(work), std::move(done), std::move(tag))};
+    return submit(Task(std::move(run)));
+}
+
+#endif
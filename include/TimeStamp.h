@@ -9,15 +9,16 @@
 #include <iostream>
 #include <string>
 #include <time.h>
+#include <stdint.h>
 
 // 时间戳类，封装一些相关的函数
 class TimeStamp
 {
 public:
-    TimeStamp(){}
+    TimeStamp() : microSecondsSinceEpoch_(0) {}
 
     // 带参构造函数，禁止隐式转换
-    explicit TimeStamp(int64_t secondSinceEpoch);
+    explicit TimeStamp(int64_t microSecondsSinceEpoch);
 
     // 静态函数，返回当前时间
     static TimeStamp now();
@@ -25,9 +26,44 @@ public:
     // 将时间戳转换为string类型
     std::string toString() const;
 
+    // 是否是有效的时间戳
+    bool valid() const { return microSecondsSinceEpoch_ > 0; }
+
+    // 返回微秒数
+    int64_t microSecondsSinceEpoch() const { return microSecondsSinceEpoch_; }
+
+    // 返回秒数
+    time_t secondsSinceEpoch() const { return static_cast<time_t>(microSecondsSinceEpoch_ / kMicroSecondsPerSecond); }
+
+    static const int kMicroSecondsPerSecond = 1000 * 1000;
+
 private:
-    // 时间戳，单位为秒
-    int64_t secondSinceEpoch_;
+    // 时间戳，单位为微秒，定时器需要比秒更细的精度
+    int64_t microSecondsSinceEpoch_;
 };
 
+inline bool operator<(TimeStamp lhs, TimeStamp rhs)
+{
+    return lhs.microSecondsSinceEpoch() < rhs.microSecondsSinceEpoch();
+}
+
+inline bool operator==(TimeStamp lhs, TimeStamp rhs)
+{
+    return lhs.microSecondsSinceEpoch() == rhs.microSecondsSinceEpoch();
+}
+
+// 两个时间戳相差的秒数
+inline double timeDifference(TimeStamp high, TimeStamp low)
+{
+    int64_t diff = high.microSecondsSinceEpoch() - low.microSecondsSinceEpoch();
+    return static_cast<double>(diff) / TimeStamp::kMicroSecondsPerSecond;
+}
+
+// 在时间戳上加上seconds秒
+inline TimeStamp addTime(TimeStamp timestamp, double seconds)
+{
+    int64_t delta = static_cast<int64_t>(seconds * TimeStamp::kMicroSecondsPerSecond);
+    return TimeStamp(timestamp.microSecondsSinceEpoch() + delta);
+}
+
 #endif
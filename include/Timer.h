@@ -0,0 +1,52 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 13:10:25
+ * @LastEditTime: 2026-10-19 13:10:25
+ */
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <atomic>
+
+#include "noncopyable.h"
+#include "TimeStamp.h"
+#include "Callbacks.h"
+
+// 定时器，记录到期时间、回调以及重复间隔
+class Timer : public muduo::noncopyable
+{
+public:
+    /**
+     * @description: Timer构造函数
+     * @param {TimerCallback} cb 到期后执行的回调
+     * @param {TimeStamp} when 到期时间
+     * @param {double} interval 重复间隔(秒)，大于0表示是重复定时器
+     */
+    Timer(TimerCallback cb, TimeStamp when, double interval)
+        : callback_(std::move(cb)),
+          expiration_(when),
+          interval_(interval),
+          repeat_(interval > 0.0),
+          sequence_(++numCreated_) {}
+
+    // 执行定时器回调
+    void run() const { callback_(); }
+
+    TimeStamp expiration() const { return expiration_; }
+    bool repeat() const { return repeat_; }
+    int64_t sequence() const { return sequence_; }
+
+    // 重复定时器重新计算下一次的到期时间
+    void restart(TimeStamp now);
+
+private:
+    const TimerCallback callback_; // 定时器回调
+    TimeStamp expiration_;         // 到期时间
+    const double interval_;        // 重复间隔
+    const bool repeat_;            // 是否重复
+    const int64_t sequence_;       // 全局唯一的序号，用于区分地址相同的新旧定时器
+
+    static std::atomic<int64_t> numCreated_; // 一共创建了多少个定时器
+};
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 13:12:03
+ * @LastEditTime: 2026-10-19 13:12:03
+ */
+#ifndef TIMER_ID_H
+#define TIMER_ID_H
+
+#include <stdint.h>
+
+class Timer;
+
+// 暴露给用户的定时器标识，用于取消定时器
+// 只保存Timer的地址和序号，Timer本身由TimerQueue管理
+class TimerId
+{
+public:
+    TimerId() : timer_(nullptr), sequence_(0) {}
+    TimerId(Timer *timer, int64_t seq) : timer_(timer), sequence_(seq) {}
+
+    friend class TimerQueue;
+
+private:
+    Timer *timer_;
+    int64_t sequence_;
+};
+
+#endif
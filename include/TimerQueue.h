@@ -0,0 +1,77 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 13:14:40
+ * @LastEditTime: 2026-10-19 13:14:40
+ */
+#ifndef TIMER_QUEUE_H
+#define TIMER_QUEUE_H
+
+#include <set>
+#include <vector>
+
+#include "noncopyable.h"
+#include "TimeStamp.h"
+#include "Channel.h"
+#include "Callbacks.h"
+#include "TimerId.h"
+
+class EventLoop;
+class Timer;
+
+/*
+TimerQueue 定时器队列
+所有定时器共用一个timerfd，timerfd总是设置成最早到期的那个定时器的时间，
+timerfd可读时由所属的EventLoop在IO线程里执行所有到期的定时器回调，
+这样定时器和IO事件在同一个线程中处理，不需要额外加锁。
+*/
+class TimerQueue : public muduo::noncopyable
+{
+public:
+    explicit TimerQueue(EventLoop *loop);
+    ~TimerQueue();
+
+    /**
+     * @description: 添加一个定时器，可以跨线程调用
+     * @param {TimerCallback} cb 到期后执行的回调
+     * @param {TimeStamp} when 到期时间
+     * @param {double} interval 重复间隔(秒)，不大于0表示只执行一次
+     */
+    TimerId addTimer(TimerCallback cb, TimeStamp when, double interval);
+
+    // 取消定时器，可以跨线程调用
+    void cancel(TimerId timerId);
+
+private:
+    // set按到期时间排序，到期时间相同的用地址区分
+    using Entry = std::pair<TimeStamp, Timer *>;
+    using TimerList = std::set<Entry>;
+    // 用于取消定时器，按地址排序
+    using ActiveTimer = std::pair<Timer *, int64_t>;
+    using ActiveTimerSet = std::set<ActiveTimer>;
+
+    void addTimerInLoop(Timer *timer);
+    void cancelInLoop(TimerId timerId);
+
+    // timerfd可读时的回调
+    void handleRead(TimeStamp receiveTime);
+
+    // 取出所有到期的定时器
+    std::vector<Entry> getExpired(TimeStamp now);
+
+    // 重复定时器重新插入，一次性定时器释放
+    void reset(const std::vector<Entry> &expired, TimeStamp now);
+
+    // 插入定时器，返回最早到期时间是否改变了
+    bool insert(Timer *timer);
+
+    EventLoop *loop_;
+    const int timerfd_;
+    Channel timerfdChannel_;
+    TimerList timers_; // 按到期时间排序的定时器
+
+    ActiveTimerSet activeTimers_;    // 和timers_保存同样的定时器，按地址排序
+    bool callingExpiredTimers_;      // 是否正在执行到期回调
+    ActiveTimerSet cancelingTimers_; // 执行到期回调期间被取消的定时器，不再重新插入
+};
+
+#endif
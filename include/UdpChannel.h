@@ -0,0 +1,150 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 16:20:08
+ * @LastEditTime: 2026-10-19 16:20:08
+ */
+#ifndef UDP_CHANNEL_H
+#define UDP_CHANNEL_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <netinet/in.h>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "Channel.h"
+#include "UdpSocket.h"
+#include "InetAddress.h"
+
+class EventLoop;
+
+/*
+UdpChannel 绑定在一个EventLoop上的UDP端点
+接收：预先分配batchSize个maxDatagramSize大小的接收缓冲区，可读时用recvmmsg一次读满一批，
+     整批交给DatagramCallback，回调返回后缓冲区马上被下一批复用，不产生任何内存分配。
+发送：send把数据报拷贝进预先分配的发送批次里，攒满一批或者本轮事件处理结束时用一次sendmmsg发出去，
+     在DatagramCallback里回复的数据报会和同一批收到的一起在回调结束后发送。
+UDP没有可靠性保证，内核发送缓冲区满(EAGAIN)时直接丢弃并计数，不做缓存。
+
+大批量收发时可以进一步让内核合并数据报：
+GRO: enableGro后内核把连续到达的同一条流的数据报合并成一个最大64KB的大包，一次recvmmsg能收到更多数据报，
+     handleRead按UDP_GRO控制消息里的段大小把大包切回原来的数据报，回调看到的依然是一个个独立的Datagram。
+GSO: sendSegmented把一段连续内存按固定大小切成多个数据报，一次sendmsg发送，协议栈只走一遍；
+     内核不支持UDP_SEGMENT时自动退化成普通的批量发送。
+*/
+class UdpChannel : public muduo::noncopyable, public std::enable_shared_from_this<UdpChannel>
+{
+public:
+    static const size_t kDefaultBatchSize = 64;         // 每次recvmmsg/sendmmsg处理的数据报个数
+    static const size_t kDefaultMaxDatagramSize = 2048; // 单个数据报的最大长度，超出的部分会被截断
+
+    /**
+     * @description: UdpChannel构造函数
+     * @param {EventLoop} *loop 所属的EventLoop
+     * @param {InetAddress} &bindAddr 绑定的本地地址
+     * @param {string} &name 名字
+     * @param {bool} reusePort 是否设置SO_REUSEPORT，多个loop各自绑定同一端口时需要
+     * @param {size_t} batchSize 每批数据报个数
+     * @param {size_t} maxDatagramSize 单个数据报最大长度
+     */
+    UdpChannel(EventLoop *loop, const InetAddress &bindAddr, const std::string &name, bool reusePort,
+               size_t batchSize = kDefaultBatchSize, size_t maxDatagramSize = kDefaultMaxDatagramSize);
+    ~UdpChannel();
+
+    // 设置收到数据报的回调
+    void setDatagramCallback(const DatagramCallback &cb) { datagramCallback_ = cb; }
+
+    // 开始接收，可以跨线程调用
+    void start();
+
+    // 停止接收，可以跨线程调用
+    void stop();
+
+    // 发送一个数据报，可以跨线程调用；在loop线程中调用时只是放入发送批次
+    void send(const InetAddress &peer, const char *data, size_t len);
+
+    // 立即把发送批次中的数据报发出去，必须在loop线程中调用
+    void flush();
+
+    // 开启GRO合并接收，必须在start之前调用，内核不支持时返回false
+    bool enableGro();
+
+    /**
+     * @description: 用GSO发送一批大小相同的数据报，可以跨线程调用
+     * @param {InetAddress} &peer 目标地址
+     * @param {char} *data 连续存放的数据报
+     * @param {size_t} len 总长度
+     * @param {size_t} segmentSize 每个数据报的大小，最后一个可以更短
+     */
+    void sendSegmented(const InetAddress &peer, const char *data, size_t len, size_t segmentSize);
+
+    EventLoop *getLoop() const { return loop_; }
+    const std::string &name() const { return name_; }
+    const InetAddress &localAddress() const { return localAddr_; }
+    UdpSocket &socket() { return socket_; }
+
+    // 统计信息，可以跨线程读取
+    uint64_t datagramsReceived() const { return received_; }
+    uint64_t datagramsSent() const { return sent_; }
+    uint64_t datagramsDropped() const { return dropped_; }
+    uint64_t datagramsTruncated() const { return truncated_; }
+    uint64_t groPackets() const { return groPackets_; } // 收到的合并包个数
+    uint64_t gsoSends() const { return gsoSends_; }     // GSO发送的次数
+
+private:
+    void startInLoop();
+    void stopInLoop();
+    void sendInLoop(const InetAddress &peer, const std::string &data);
+    void sendSegmentedInLoop(const InetAddress &peer, const std::string &data, size_t segmentSize);
+
+    // 按当前的槽大小分配接收批次的缓冲区
+    void setupRecvBatch();
+
+    // 可读事件回调
+    void handleRead(TimeStamp receiveTime);
+
+    // 放入发送批次
+    void appendToSendBatch(const InetAddress &peer, const char *data, size_t len);
+
+    EventLoop *loop_;
+    const std::string name_;
+    const InetAddress localAddr_;
+    UdpSocket socket_;
+    Channel channel_;
+    DatagramCallback datagramCallback_;
+
+    const size_t batchSize_;
+    const size_t maxDatagramSize_;
+
+    // 接收批次
+    size_t recvBatchSize_;            // 每次recvmmsg的消息个数
+    size_t recvSlotSize_;             // 每个消息的缓冲区大小，开启GRO后要能放下一个合并包
+    std::vector<char> recvBuffer_;
+    std::vector<char> recvControl_;   // 接收UDP_GRO控制消息
+    std::vector<struct mmsghdr> recvMsgs_;
+    std::vector<struct iovec> recvIovecs_;
+    std::vector<sockaddr_storage> recvAddrs_;
+    std::vector<Datagram> datagrams_; // 切分后交给回调的数据报，开启GRO后个数可能多于recvBatchSize_
+    bool groEnabled_;
+    bool gsoSupported_; // 第一次GSO发送失败后置为false，之后都走普通的批量发送
+
+    // 发送批次
+    std::vector<char> sendBuffer_;
+    std::vector<struct mmsghdr> sendMsgs_;
+    std::vector<struct iovec> sendIovecs_;
+    std::vector<sockaddr_storage> sendAddrs_;
+    size_t pendingSends_;  // 发送批次中的数据报个数
+    bool flushScheduled_;  // 是否已经安排在doPendingFunctors中flush
+    bool inReadCallback_;  // 是否正在handleRead中，此时由handleRead负责flush
+
+    std::atomic<uint64_t> received_;
+    std::atomic<uint64_t> sent_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> truncated_;
+    std::atomic<uint64_t> groPackets_;
+    std::atomic<uint64_t> gsoSends_;
+};
+
+#endif
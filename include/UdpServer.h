@@ -0,0 +1,83 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 16:50:29
+ * @LastEditTime: 2026-10-19 16:50:29
+ */
+#ifndef UDP_SERVER_H
+#define UDP_SERVER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "InetAddress.h"
+#include "EventLoopThreadPool.h"
+#include "UdpChannel.h"
+
+class EventLoop;
+
+/*
+UDP服务器类
+kNoReusePort: 只在baseLoop上创建一个UdpChannel，所有数据报都在baseLoop中处理
+kReusePort:   每个subLoop(没有subLoop时是baseLoop)各自创建一个设置了SO_REUSEPORT、绑定同一端口的UdpChannel，
+              由内核按四元组哈希把数据报分散到各个socket上，各个loop之间没有任何共享状态
+*/
+class UdpServer : public muduo::noncopyable
+{
+public:
+    using ThreadInitCallback = std::function<void(EventLoop *)>;
+
+    enum Option
+    {
+        kNoReusePort,
+        kReusePort,
+    };
+
+    /**
+     * @description: UdpServer构造函数
+     * @param {EventLoop} *loop baseLoop，由用户自己创建
+     * @param {InetAddress} &listenAddr 监听的网络地址
+     * @param {string} &nameArg 服务器名字
+     * @param {Option} option 是否每个loop各自绑定一个SO_REUSEPORT的socket
+     */
+    UdpServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &nameArg, Option option = kNoReusePort);
+    ~UdpServer();
+
+    // 设置loop线程初始化的回调
+    void setThreadInitcallback(const ThreadInitCallback &cb) { threadInitCallback_ = cb; }
+
+    // 设置收到数据报的回调
+    void setDatagramCallback(const DatagramCallback &cb) { datagramCallback_ = cb; }
+
+    // 设置底层subloop个数，只在kReusePort模式下有意义
+    void setThreadNum(int numThreads) { threadPool_->setThreadNum(numThreads); }
+
+    // 设置每批收发的数据报个数和单个数据报的最大长度，需要在start之前调用
+    void setBatchSize(size_t batchSize) { batchSize_ = batchSize; }
+    void setMaxDatagramSize(size_t maxDatagramSize) { maxDatagramSize_ = maxDatagramSize; }
+
+    // 开启服务器
+    void start();
+
+    // 返回所有的UdpChannel，start之后才有
+    const std::vector<UdpChannelPtr> &channels() const { return channels_; }
+
+private:
+    EventLoop *loop_;
+    const InetAddress listenAddr_;
+    const std::string name_;
+    const Option option_;
+    std::shared_ptr<EventLoopThreadPool> threadPool_;
+    DatagramCallback datagramCallback_;
+    ThreadInitCallback threadInitCallback_;
+    size_t batchSize_;
+    size_t maxDatagramSize_;
+    std::atomic<int> started_;
+    std::vector<UdpChannelPtr> channels_;
+};
+
+#endif
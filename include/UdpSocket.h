@@ -0,0 +1,78 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 16:05:12
+ * @LastEditTime: 2026-10-19 16:05:12
+ */
+#ifndef UDP_SOCKET_H
+#define UDP_SOCKET_H
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include "noncopyable.h"
+#include "Socket.h"
+#include "InetAddress.h"
+
+// 收到的一个UDP数据报，data指向UdpChannel预先分配的接收缓冲区，只在回调期间有效
+struct Datagram
+{
+    const char *data;
+    size_t len;
+    InetAddress peer;
+};
+
+// 非阻塞UDP socket封装类，批量收发使用recvmmsg/sendmmsg，一次系统调用处理多个数据报
+class UdpSocket : public muduo::noncopyable
+{
+public:
+    explicit UdpSocket(sa_family_t family = AF_INET); // 创建一个非阻塞的UDP socket，family为AF_INET或AF_INET6
+
+    int fd() const { return socket_.fd(); }                                // 获取文件描述符
+    void bindAddress(const InetAddress &localaddr) { socket_.bindAddress(localaddr); } // 绑定本地地址
+    void setReuseAddr(bool on) { socket_.setReuseAddr(on); }               // 重用本地地址
+    void setReusePort(bool on) { socket_.setReusePort(on); }               // 重用端口，多个socket绑定同一端口由内核做负载均衡
+    void setRecvBufferSize(int bytes);                                     // 设置内核接收缓冲区大小
+    void setSendBufferSize(int bytes);                                     // 设置内核发送缓冲区大小
+
+    /**
+     * @description: 调用recvmmsg批量读取数据报
+     * @param {mmsghdr} *msgs 预先设置好缓冲区的消息数组
+     * @param {unsigned} count 最多读取的个数
+     * @param {int} *saveErrno 函数运行时产生的错误
+     * @return {int} 读到的数据报个数，出错返回-1
+     */
+    int recvBatch(struct mmsghdr *msgs, unsigned int count, int *saveErrno);
+
+    /**
+     * @description: 调用sendmmsg批量发送数据报
+     * @return {int} 发送出去的数据报个数，出错返回-1
+     */
+    int sendBatch(struct mmsghdr *msgs, unsigned int count, int *saveErrno);
+
+    // 发送单个数据报
+    ssize_t sendTo(const void *data, size_t len, const InetAddress &peer, int *saveErrno);
+
+    /**
+     * @description: 开启UDP_GRO，内核把同一条流上连续到达的数据报合并成一个大包交给recvmsg，
+     *               每个包附带UDP_GRO控制消息说明原始数据报的大小
+     * @return {bool} 内核不支持时返回false
+     */
+    bool setGro(bool on);
+
+    /**
+     * @description: 使用UDP_SEGMENT(GSO)发送，一次sendmsg把data按segmentSize切成多个数据报，
+     *               切分发生在协议栈最底层(或网卡)，上层只走一遍
+     * @param {size_t} len 总长度，最多kMaxGsoSegments个分段
+     * @param {uint16_t} segmentSize 每个数据报的大小，最后一个可以更短
+     * @return {ssize_t} 发送的字节数，出错返回-1
+     */
+    ssize_t sendSegmented(const void *data, size_t len, uint16_t segmentSize, const InetAddress &peer, int *saveErrno);
+
+    static const size_t kMaxGsoSegments = 64;    // 内核限制的单次GSO最大分段数(UDP_MAX_SEGMENTS)
+    static const size_t kMaxGsoBytes = 65000;    // 单次GSO的最大字节数，受IP包长度限制
+
+private:
+    Socket socket_; // 复用Socket管理fd的生命周期和通用选项
+};
+
+#endif
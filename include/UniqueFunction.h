@@ -0,0 +1,62 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 11:02:36
+ * @LastEditTime: 2026-10-20 11:02:36
+ */
+#ifndef UNIQUE_FUNCTION_H
+#define UNIQUE_FUNCTION_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/*
+UniqueFunction 只能移动的回调
+std::function要求可调用对象可以拷贝，持有std::unique_ptr等只能移动的对象的函数对象放不进去；
+UniqueFunction只要求可以移动，用于ThreadPool的任务队列，任务和它携带的数据都只移动、不拷贝。
+
+C++11的lambda不能按移动捕获，需要携带只能移动的数据时，写一个带operator()的结构体传进来。
+*/
+
+template <typename Signature>
+class UniqueFunction;
+
+template <typename R, typename... Args>
+class UniqueFunction<R(Args...)>
+{
+public:
+    UniqueFunction() {}
+    UniqueFunction(std::nullptr_t) {}
+
+    template <typename F,
+              typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, UniqueFunction>::value>::type>
+    UniqueFunction(F &&f) : callable_(new Callable<typename std::decay<F>::type>(std::forward<F>(f))) {}
+
+    UniqueFunction(UniqueFunction &&) = default;
+    UniqueFunction &operator=(UniqueFunction &&) = default;
+
+    R operator()(Args... args) { return callable_->call(std::forward<Args>(args)...); }
+
+    // 是否持有可调用对象
+    explicit operator bool() const { return callable_ != nullptr; }
+
+private:
+    struct CallableBase
+    {
+        virtual ~CallableBase() {}
+        virtual R call(Args... args) = 0;
+    };
+
+    template <typename F>
+    struct Callable : CallableBase
+    {
+        explicit Callable(F &&f) : f_(std::move(f)) {}
+        explicit Callable(const F &f) : f_(f) {}
+        R call(Args... args) override { return f_(std::forward<Args>(args)...); }
+        F f_;
+    };
+
+    std::unique_ptr<CallableBase> callable_;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 15:20:44
+ * @LastEditTime: 2026-10-19 15:20:44
+ */
+#ifndef UPSTREAM_POOL_H
+#define UPSTREAM_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "Callbacks.h"
+#include "InetAddress.h"
+#include "TimeStamp.h"
+
+class EventLoop;
+class TcpClient;
+
+/*
+UpstreamPool 客户端长连接池
+在一个EventLoop上维护到同一个后端的若干条长连接(TcpClient，断线自动重连)。
+请求直接写到连接上，不等前一个响应回来(pipelining)，同一条连接上的响应按请求顺序返回，
+所以每条连接用一个FIFO队列记录还没收到响应的回调。
+
+每次call选择已连接、且未达到maxInFlight上限的连接中排队请求最少的一条(least outstanding)。
+所有操作都要求在loop线程中进行：在TcpServer的ThreadInitCallback里给每个subLoop创建一个UpstreamPool，
+onMessage里就可以直接向后端扇出请求，响应也在同一个线程里回调，不需要跨线程。
+*/
+class UpstreamPool : public muduo::noncopyable
+{
+public:
+    // 响应回调，ok为false表示连接断开，请求没有得到响应
+    using ResponseCallback = std::function<void(bool ok, const std::string &response)>;
+
+    // 从接收缓冲区开头切分出一个完整的响应，返回它的字节数；数据还不完整时返回0
+    using ResponseSplitter = std::function<size_t(const Buffer *buf)>;
+
+    static const size_t kDefaultMaxInFlight = 64; // 每条连接默认最多排队的请求数
+
+    /**
+     * @description: UpstreamPool构造函数
+     * @param {EventLoop} *loop 连接所在的EventLoop
+     * @param {InetAddress} &serverAddr 后端地址
+     * @param {string} &name 名字
+     * @param {int} numConnections 连接数
+     * @param {ResponseSplitter} splitter 响应切分函数
+     */
+    UpstreamPool(EventLoop *loop, const InetAddress &serverAddr, const std::string &name,
+                 int numConnections, const ResponseSplitter &splitter);
+
+    // 必须在loop线程中析构
+    ~UpstreamPool();
+
+    // 设置每条连接最多排队的请求数
+    void setMaxInFlight(size_t maxInFlight) { maxInFlight_ = maxInFlight; }
+
+    // 建立所有连接
+    void start();
+
+    // 断开所有连接，不再重连
+    void stop();
+
+    /**
+     * @description: 发送一个请求，必须在loop线程中调用
+     * @param {string} &request 已经编码好的请求
+     * @param {ResponseCallback} cb 收到响应或连接断开时的回调
+     * @return {bool} 没有可用的连接或所有连接都达到上限时返回false，请求不会被发送
+     */
+    bool call(const std::string &request, const ResponseCallback &cb);
+
+    // 已连接的连接数
+    size_t connectedCount() const;
+
+    // 所有连接上还没收到响应的请求数
+    size_t inFlight() const;
+
+    EventLoop *getLoop() const { return loop_; }
+
+private:
+    struct Upstream
+    {
+        std::unique_ptr<TcpClient> client;
+        TcpConnectionPtr conn;                 // 已连接时非空
+        std::deque<ResponseCallback> pending; // 按发送顺序排队等待响应的回调
+    };
+
+    void onConnection(size_t index, const TcpConnectionPtr &conn);
+    void onMessage(size_t index, const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    // 连接断开时，让还在排队的请求全部失败
+    void failPending(Upstream &upstream);
+
+    EventLoop *loop_;
+    const std::string name_;
+    ResponseSplitter splitter_;
+    size_t maxInFlight_;
+    std::vector<Upstream> upstreams_;
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:15:40
+ * @LastEditTime: 2026-10-19 21:15:40
+ */
+#ifndef WEB_SOCKET_CODEC_H
+#define WEB_SOCKET_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "StringPiece.h"
+
+class Buffer;
+
+/*
+WebSocketCodec WebSocket(RFC 6455)帧的编解码
+  0                   1                   2                   3
+  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ +-+-+-+-+-------+-+-------------+-------------------------------+
+ |F|R|R|R| opcode|M| Payload len |    Extended payload length    |
+ |I|S|S|S|  (4)  |A|     (7)     |             (16/64)           |
+ |N|V|V|V|       |S|             |   (if payload len==126/127)   |
+ +-+-+-+-+-------+-+-------------+-------------------------------+
+ |                 Masking-key (0 or 4 bytes)                    |
+ +---------------------------------------------------------------+
+ |                        Payload Data                           |
+ +---------------------------------------------------------------+
+
+解码只解析帧头，负载留在inputBuffer_里就地去掩码；编码直接把帧头和负载写进目标Buffer。
+*/
+class WebSocketCodec
+{
+public:
+    enum Opcode
+    {
+        kContinuation = 0x0,
+        kText = 0x1,
+        kBinary = 0x2,
+        kClose = 0x8,
+        kPing = 0x9,
+        kPong = 0xA
+    };
+
+    // 关闭帧的状态码
+    enum CloseCode
+    {
+        kNormalClosure = 1000,
+        kGoingAway = 1001,
+        kProtocolError = 1002,
+        kUnsupportedData = 1003,
+        kMessageTooBig = 1009
+    };
+
+    static const size_t kMaxHeaderLen = 14;        // 帧头最长14字节：2 + 8字节长度 + 4字节掩码
+    static const size_t kMaxControlPayload = 125;  // 控制帧负载的最大长度
+
+    struct FrameHeader
+    {
+        bool fin;
+        int opcode;
+        bool masked;
+        uint8_t maskKey[4];
+        size_t headerLen;   // 帧头的字节数
+        uint64_t payloadLen; // 负载的字节数
+    };
+
+    /**
+     * @description: 解析帧头
+     * @param {char} *data 数据起始地址
+     * @param {size_t} len 数据长度
+     * @param {FrameHeader} *header 输出的帧头
+     * @return 1表示解析出了完整的帧头，0表示数据不够，-1表示帧头非法（保留位非0、未知opcode、控制帧不合规）
+     */
+    static int parseHeader(const char *data, size_t len, FrameHeader *header);
+
+    /**
+     * @description: 就地对数据做掩码异或，用于客户端帧去掩码
+     * @param {char} *data 负载
+     * @param {size_t} len 负载长度
+     * @param {uint8_t} *maskKey 4字节掩码
+     */
+    static void applyMask(char *data, size_t len, const uint8_t *maskKey);
+
+    // 按负载长度计算服务端帧（不带掩码）的帧头长度
+    static size_t headerLength(size_t payloadLen) { return payloadLen < 126 ? 2 : (payloadLen <= 0xFFFF ? 4 : 10); }
+
+    /**
+     * @description: 把一个服务端帧（不带掩码）追加到out后面
+     * @param {Buffer} *out 目标缓冲区，一般是TcpConnection::outputBuffer()
+     * @param {int} opcode 帧类型
+     * @param {StringPiece} &payload 负载
+     */
+    static void encode(Buffer *out, int opcode, const StringPiece &payload);
+
+    // 编码成一个独立的字符串，用于广播时只编码一次、所有连接共享
+    static std::string encodeToString(int opcode, const StringPiece &payload);
+
+    /**
+     * @description: 在payload的可读数据前面就地补上帧头，负载本身不移动
+     * 帧头不超过kCheapPrepend(8字节)时只用预留空间；负载超过64KB时帧头为10字节，需要Buffer腾出额外的空间
+     * @param {Buffer} *payload 可读数据为负载的缓冲区
+     * @param {int} opcode 帧类型
+     */
+    static void prependHeader(Buffer *payload, int opcode);
+
+    // 根据客户端的Sec-WebSocket-Key计算Sec-WebSocket-Accept
+    static std::string acceptKey(const StringPiece &clientKey);
+
+private:
+    // 把帧头写到header中，返回帧头长度
+    static size_t writeHeader(char *header, int opcode, size_t payloadLen);
+};
+
+#endif
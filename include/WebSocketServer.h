@@ -0,0 +1,90 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:36:02
+ * @LastEditTime: 2026-10-19 21:36:02
+ */
+#ifndef WEB_SOCKET_SERVER_H
+#define WEB_SOCKET_SERVER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "TcpServer.h"
+#include "HttpServer.h"
+#include "StringPiece.h"
+
+class HttpRequest;
+
+/*
+WebSocketServer WebSocket(RFC 6455)服务器
+连接建立后先用HttpParser解析握手请求，校验通过后回复101，之后同一个inputBuffer_里的数据按帧解析。
+- 完整的、不分片的消息直接在inputBuffer_里去掩码，以StringPiece交给上层，不拷贝；分片消息才拼接到连接的缓冲里
+- ping自动回复pong，收到close回复close后关闭连接
+- 不是升级请求的普通HTTP请求交给HttpCallback处理，同一个端口可以同时提供HTTP接口
+
+发送时在IO线程里直接把帧编码进outputBuffer_；broadcast只编码一次，所有订阅者共享同一份帧数据。
+不支持扩展（permessage-deflate等），不校验文本消息的UTF-8编码。
+*/
+class WebSocketServer : public muduo::noncopyable
+{
+public:
+    // 收到一条完整的消息，message只在回调期间有效
+    using WsMessageCallback = std::function<void(const TcpConnectionPtr &, StringPiece message, bool binary, TimeStamp)>;
+
+    // 握手完成(conn->connected()为true)和握手完成后连接断开时回调
+    using WsConnectionCallback = std::function<void(const TcpConnectionPtr &)>;
+
+    // 握手请求的校验，返回false时回复403，可以用来检查路径、Origin等
+    using HandshakeCallback = std::function<bool(const TcpConnectionPtr &, const HttpRequest &)>;
+
+    static const size_t kDefaultMaxMessageSize = 16 * 1024 * 1024; // 默认的最大消息长度
+
+    WebSocketServer(EventLoop *loop,
+                    const InetAddress &listenAddr,
+                    const std::string &name,
+                    TcpServer::Option option = TcpServer::kNoReusePort);
+
+    void setMessageCallback(const WsMessageCallback &cb) { messageCallback_ = cb; }
+    void setConnectionCallback(const WsConnectionCallback &cb) { connectionCallback_ = cb; }
+    void setHandshakeCallback(const HandshakeCallback &cb) { handshakeCallback_ = cb; }
+
+    // 处理普通HTTP请求，不设置时回复426
+    void setHttpCallback(const HttpServer::HttpCallback &cb) { httpCallback_ = cb; }
+
+    // 设置最大消息长度，超过时以1009关闭连接
+    void setMaxMessageSize(size_t size) { maxMessageSize_ = size; }
+
+    void setThreadNum(int numThreads) { server_.setThreadNum(numThreads); }
+    void setThreadInitCallback(const TcpServer::ThreadInitCallback &cb) { server_.setThreadInitcallback(cb); }
+    void start() { server_.start(); }
+
+    // 发送一条消息，可以在任意线程调用
+    static void send(const TcpConnectionPtr &conn, const StringPiece &message, bool binary = false);
+
+    // 发送关闭帧并关闭连接
+    static void close(const TcpConnectionPtr &conn, int code = 1000, const StringPiece &reason = StringPiece());
+
+    // 向多个连接发送同一条消息，帧只编码一次
+    static void broadcast(const std::vector<TcpConnectionPtr> &conns, const StringPiece &message, bool binary = false);
+
+private:
+    void onConnection(const TcpConnectionPtr &conn);
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    // 处理握手阶段的数据，返回false表示连接已经关闭或还需要更多数据
+    bool handleHandshake(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    // 解析并处理buf中的所有完整帧
+    void handleFrames(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime);
+
+    TcpServer server_;
+    WsMessageCallback messageCallback_;
+    WsConnectionCallback connectionCallback_;
+    HandshakeCallback handshakeCallback_;
+    HttpServer::HttpCallback httpCallback_;
+    size_t maxMessageSize_;
+};
+
+#endif
@@ -5,34 +5,63 @@
  */
 #include "Acceptor.h"
 
+#include <errno.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include "Logger.h"
 #include "InetAddress.h"
+#include "PhaseStats.h"
 
-// 创建一个非阻塞的IO
-static int createNonblocking()
+// 创建一个非阻塞的IO，family为AF_INET、AF_INET6或AF_UNIX
+static int createNonblocking(sa_family_t family)
 {
-    int sockfd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+    int sockfd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (sockfd < 0)
         LOG_FATAL("%s:%s:%d listen socket create err:%d \n", __FILE__, __FUNCTION__, __LINE__, errno);
     return sockfd;
 }
 
+// Unix域socket文件在进程退出后会残留，不删除的话bind会失败
+// 只删除没人监听的socket文件：路径上是普通文件说明配置错了，能连上说明另一个服务器还在用，都拒绝启动
+static void removeStaleUnixSocket(const InetAddress &listenAddr)
+{
+    std::string path = listenAddr.toIp();
+    struct stat st;
+    if (::lstat(path.c_str(), &st) < 0)
+        return; // 不存在，直接bind
+    if (!S_ISSOCK(st.st_mode))
+        LOG_FATAL("%s:%s:%d %s exists and is not a socket \n", __FILE__, __FUNCTION__, __LINE__, path.c_str());
+
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0)
+        LOG_FATAL("%s:%s:%d probe socket create err:%d \n", __FILE__, __FUNCTION__, __LINE__, errno);
+    int ret = ::connect(probe, listenAddr.getSockAddr(), listenAddr.getSockLen());
+    int savedErrno = errno;
+    ::close(probe);
+    if (ret == 0)
+        LOG_FATAL("%s:%s:%d %s is in use by another server \n", __FILE__, __FUNCTION__, __LINE__, path.c_str());
+    if (savedErrno == ECONNREFUSED)
+        ::unlink(path.c_str());
+}
+
 Acceptor::Acceptor(EventLoop *loop, const InetAddress &listenAddr, bool reuseport)
     : loop_(loop),
-      acceptSocket_(createNonblocking()),
+      acceptSocket_(createNonblocking(listenAddr.family())),
       acceptChannel_(loop, acceptSocket_.fd()), // 这里的loop是baseLoop_
       listenning_(false)
 {
     acceptSocket_.setReuseAddr(true);      // 设置socket选项
-    acceptSocket_.setReusePort(true);      // 设置socket选项
+    acceptSocket_.setReusePort(reuseport); // 设置socket选项
+    if (listenAddr.family() == AF_UNIX)
+        removeStaleUnixSocket(listenAddr);
     acceptSocket_.bindAddress(listenAddr); // bind
     // TcpServer::start() Acceptor.listen 有新用户连接 执行一个回调 connfd => channel => subloop
     // baseLoop_ 监听到Accpetor有监听事件，baseLoop_就会帮我们新客户连接的回调函数
-    acceptChannel_.setReadCallback(std::bind(&Acceptor::handleRead, this));
+    acceptChannel_.setReadCallback(Channel::ReadEventCallback::fromMethod<Acceptor, &Acceptor::handleRead>(this));
+    acceptChannel_.setName("Acceptor");
 }
 
 Acceptor::~Acceptor()
@@ -48,8 +77,9 @@ void Acceptor::listen()
     acceptChannel_.enableReading();
 }
 
-void Acceptor::handleRead()
+void Acceptor::handleRead(TimeStamp /*receiveTime*/)
 {
+    PhaseStats::Scope phase(PhaseStats::kAcceptorHandleRead);
     // server socket fd 有读事件发生了，即有新用户连接了，就会调用这个handleRead
     InetAddress peerAddr;
     // 当有新用户连接了又会调用Socket::accpet函数，该函数底层真正调用了sccket编程的accept函数
@@ -0,0 +1,48 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:03:12
+ * @LastEditTime: 2026-10-19 21:03:12
+ */
+#include "Base64.h"
+
+#include <stdint.h>
+
+namespace Base64
+{
+
+    static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string encode(const void *data, size_t len)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        std::string result;
+        result.reserve((len + 2) / 3 * 4);
+
+        size_t i = 0;
+        for (; i + 3 <= len; i += 3)
+        {
+            uint32_t n = (p[i] << 16) | (p[i + 1] << 8) | p[i + 2];
+            result += kAlphabet[(n >> 18) & 0x3F];
+            result += kAlphabet[(n >> 12) & 0x3F];
+            result += kAlphabet[(n >> 6) & 0x3F];
+            result += kAlphabet[n & 0x3F];
+        }
+        if (i + 1 == len)
+        {
+            uint32_t n = p[i] << 16;
+            result += kAlphabet[(n >> 18) & 0x3F];
+            result += kAlphabet[(n >> 12) & 0x3F];
+            result += "==";
+        }
+        else if (i + 2 == len)
+        {
+            uint32_t n = (p[i] << 16) | (p[i + 1] << 8);
+            result += kAlphabet[(n >> 18) & 0x3F];
+            result += kAlphabet[(n >> 12) & 0x3F];
+            result += kAlphabet[(n >> 6) & 0x3F];
+            result += '=';
+        }
+        return result;
+    }
+
+}
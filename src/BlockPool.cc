@@ -0,0 +1,55 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 10:12:40
+ * @LastEditTime: 2026-10-19 10:12:40
+ */
+#include "BlockPool.h"
+
+#include <new>
+
+BlockPool::BlockPool(size_t maxCached)
+    : blockSize_(0),
+      maxCached_(maxCached)
+{
+}
+
+BlockPool::~BlockPool()
+{
+    for (void *p : freeList_)
+        ::operator delete(p);
+}
+
+void *BlockPool::allocate(size_t size)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (blockSize_ == 0)
+            blockSize_ = size; // 池只服务一种大小，由第一次分配决定
+        if (size == blockSize_ && !freeList_.empty())
+        {
+            void *p = freeList_.back();
+            freeList_.pop_back();
+            return p;
+        }
+    }
+    return ::operator new(size);
+}
+
+void BlockPool::deallocate(void *p, size_t size)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (size == blockSize_ && freeList_.size() < maxCached_)
+        {
+            freeList_.push_back(p);
+            return;
+        }
+    }
+    ::operator delete(p);
+}
+
+size_t BlockPool::cachedBlocks() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return freeList_.size();
+}
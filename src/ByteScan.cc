@@ -0,0 +1,225 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 20:10:51
+ * @LastEditTime: 2026-10-19 20:10:51
+ */
+#include "ByteScan.h"
+
+#include <string.h>
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BYTE_SCAN_X86 1
+#endif
+
+namespace ByteScan
+{
+
+    const char *findByteScalar(const char *begin, const char *end, char c)
+    {
+        for (const char *p = begin; p < end; ++p)
+        {
+            if (*p == c)
+                return p;
+        }
+        return nullptr;
+    }
+
+    const char *findCRLFScalar(const char *begin, const char *end)
+    {
+        for (const char *p = begin; p + 1 < end; ++p)
+        {
+            if (p[0] == '\r' && p[1] == '\n')
+                return p;
+        }
+        return nullptr;
+    }
+
+#ifdef BYTE_SCAN_X86
+
+    const char *findByteSse2(const char *begin, const char *end, char c)
+    {
+        if (end - begin < 16)
+            return findByteScalar(begin, end, c);
+        const __m128i needle = _mm_set1_epi8(c);
+        const char *p = begin;
+        for (;; p += 16)
+        {
+            if (p + 16 > end)
+            {
+                // 剩下不足16字节时，让最后一次加载和前面的块重叠，不再逐字节比较
+                // 重叠部分前面已经比较过，不会匹配
+                if (p == end)
+                    return nullptr;
+                p = end - 16;
+            }
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+            if (p + 16 == end)
+                return nullptr;
+        }
+    }
+
+    const char *findCRLFSse2(const char *begin, const char *end)
+    {
+        // 同时加载p和p+1开始的16字节，'\r'的位置和'\n'的位置对齐后按位与
+        if (end - begin < 17)
+            return findCRLFScalar(begin, end);
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const char *p = begin;
+        for (;; p += 16)
+        {
+            if (p + 17 > end)
+            {
+                if (p + 1 >= end)
+                    return nullptr;
+                p = end - 17; // 和findByteSse2一样用重叠的加载处理结尾
+            }
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 1));
+            int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, cr), _mm_cmpeq_epi8(second, lf)));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+            if (p + 17 == end)
+                return nullptr;
+        }
+    }
+
+    __attribute__((target("avx2"))) static const char *findByteAvx2Impl(const char *begin, const char *end, char c)
+    {
+        if (end - begin < 32)
+            return findByteSse2(begin, end, c);
+        const __m256i needle = _mm256_set1_epi8(c);
+        const char *p = begin;
+        for (;; p += 32)
+        {
+            if (p + 32 > end)
+            {
+                if (p == end)
+                    return nullptr;
+                p = end - 32;
+            }
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+            if (p + 32 == end)
+                return nullptr;
+        }
+    }
+
+    __attribute__((target("avx2"))) static const char *findCRLFAvx2Impl(const char *begin, const char *end)
+    {
+        if (end - begin < 33)
+            return findCRLFSse2(begin, end);
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const char *p = begin;
+        for (;; p += 32)
+        {
+            if (p + 33 > end)
+            {
+                if (p + 1 >= end)
+                    return nullptr;
+                p = end - 33;
+            }
+            __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 1));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(first, cr), _mm256_cmpeq_epi8(second, lf))));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+            if (p + 33 == end)
+                return nullptr;
+        }
+    }
+
+    static bool hasAvx2()
+    {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    const char *findByteAvx2(const char *begin, const char *end, char c)
+    {
+        return hasAvx2() ? findByteAvx2Impl(begin, end, c) : findByteSse2(begin, end, c);
+    }
+
+    const char *findCRLFAvx2(const char *begin, const char *end)
+    {
+        return hasAvx2() ? findCRLFAvx2Impl(begin, end) : findCRLFSse2(begin, end);
+    }
+
+#else
+
+    const char *findByteSse2(const char *begin, const char *end, char c) { return findByteScalar(begin, end, c); }
+    const char *findByteAvx2(const char *begin, const char *end, char c) { return findByteScalar(begin, end, c); }
+    const char *findCRLFSse2(const char *begin, const char *end) { return findCRLFScalar(begin, end); }
+    const char *findCRLFAvx2(const char *begin, const char *end) { return findCRLFScalar(begin, end); }
+
+#endif
+
+    using FindByteFunc = const char *(*)(const char *, const char *, char);
+    using FindCRLFFunc = const char *(*)(const char *, const char *);
+
+    static const char *resolveFindByte(const char *begin, const char *end, char c);
+    static const char *resolveFindCRLF(const char *begin, const char *end);
+
+    // 函数指针一开始指向resolve函数，第一次调用时换成真正的实现，之后的调用只有一次间接跳转
+    // 多个线程同时第一次调用时会各自解析一遍，写入的值相同，relaxed的原子读写就够了
+    static std::atomic<FindByteFunc> g_findByte(resolveFindByte);
+    static std::atomic<FindCRLFFunc> g_findCRLF(resolveFindCRLF);
+
+    const char *implName()
+    {
+#ifdef BYTE_SCAN_X86
+        return hasAvx2() ? "avx2" : "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+    static const char *resolveFindByte(const char *begin, const char *end, char c)
+    {
+#ifdef BYTE_SCAN_X86
+        FindByteFunc f = hasAvx2() ? findByteAvx2Impl : findByteSse2;
+#else
+        FindByteFunc f = findByteScalar;
+#endif
+        g_findByte.store(f, std::memory_order_relaxed);
+        return f(begin, end, c);
+    }
+
+    static const char *resolveFindCRLF(const char *begin, const char *end)
+    {
+#ifdef BYTE_SCAN_X86
+        FindCRLFFunc f = hasAvx2() ? findCRLFAvx2Impl : findCRLFSse2;
+#else
+        FindCRLFFunc f = findCRLFScalar;
+#endif
+        g_findCRLF.store(f, std::memory_order_relaxed);
+        return f(begin, end);
+    }
+
+    const char *findByte(const char *begin, const char *end, char c)
+    {
+#ifdef __GLIBC__
+        // glibc的memchr本身就按CPU选择了SSE2/AVX2/EVEX实现，并且用对齐加载处理了边界，
+        // 实测(benchmark/find_crlf)比这里的实现还要快，所以单字节查找直接交给它
+        return static_cast<const char *>(::memchr(begin, c, end - begin));
+#else
+        return g_findByte.load(std::memory_order_relaxed)(begin, end, c);
+#endif
+    }
+
+    const char *findCRLF(const char *begin, const char *end)
+    {
+        return g_findCRLF.load(std::memory_order_relaxed)(begin, end);
+    }
+
+}
@@ -7,6 +7,7 @@
 #include "Channel.h"
 #include "Logger.h"
 #include "EventLoop.h"
+#include "Probes.h"
 #include <sys/epoll.h>
 
 const int Channel::kNoneEvent = 0;
@@ -14,7 +15,7 @@ const int Channel::kReadEvent = EPOLLIN | EPOLLPRI;
 const int Channel::kWriteEvent = EPOLLOUT;
 
 Channel::Channel(EventLoop *loop, int fd)
-    : loop_(loop), fd_(fd), events_(0), revents_(0), status_(-1), tied_(false) {}
+    : loop_(loop), fd_(fd), events_(0), revents_(0), status_(-1), name_(nullptr), tied_(false) {}
 
 Channel::~Channel() {}
 
@@ -48,10 +49,11 @@ void Channel::HandlerEvent(TimeStamp receiveTime)
 {
     if (tied_)
     {
-        // lock返回一个weak_ptr指向相同的shared_ptr，如果已经被释放则返回null
         // tie_绑定一个TCPConnection，用于避免连接被释放后回调函数的执行
-        std::shared_ptr<void> guard = tie_.lock();
-        if (guard)
+        // 连接的最后一个引用只会在所属loop的doPendingFunctors里、connectDestroyed把channel移出poller之后才释放，
+        // 而事件分发和doPendingFunctors在同一个线程里串行执行，分发期间连接不会被析构。
+        // 所以这里只检查连接是否已经释放(一次原子读)，不必每个事件都lock出一个shared_ptr(两次原子读改写)
+        if (!tie_.expired())
             HandleEventWithGuard(receiveTime);
     }
     else
@@ -61,7 +63,8 @@ void Channel::HandlerEvent(TimeStamp receiveTime)
 void Channel::HandleEventWithGuard(TimeStamp receiveTime)
 {
     // 打印日志
-    LOG_INFO("channel HandleEvent revents:%d", revents_);
+    LOG_DEBUG("channel HandleEvent revents:%d", revents_);
+    MYMUDUO_PROBE2(handle_event_begin, fd_, revents_);
     if ((revents_ & EPOLLHUP) && !(revents_ & EPOLLIN))
     {
         // 设备断开连接且无数据可读
@@ -86,4 +89,5 @@ void Channel::HandleEventWithGuard(TimeStamp receiveTime)
         if (write_callback_)
             write_callback_();
     }
+    MYMUDUO_PROBE2(handle_event_end, fd_, revents_);
 }
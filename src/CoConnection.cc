@@ -0,0 +1,111 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 14:33:12
+ * @LastEditTime: 2026-10-20 14:33:12
+ */
+
+// 只有打开MYMUDUO_COROUTINE选项（C++20）时才编译
+#ifdef MYMUDUO_COROUTINE
+
+#include "CoConnection.h"
+
+#include <algorithm>
+
+CoConnectionPtr CoConnection::attach(const TcpConnectionPtr &conn)
+{
+    CoConnectionPtr co = std::make_shared<CoConnection>(conn);
+    std::weak_ptr<CoConnection> weakCo(co);
+    conn->setMessageCallback([weakCo](const TcpConnectionPtr &c, Buffer *buf, TimeStamp receiveTime)
+                             {
+        CoConnectionPtr co = weakCo.lock();
+        if (co)
+            co->onMessage(c, buf, receiveTime);
+        else
+            buf->retrieveAll(); });
+    conn->setWriteCompleteCallback([weakCo](const TcpConnectionPtr &c)
+                                   {
+        CoConnectionPtr co = weakCo.lock();
+        if (co)
+            co->onWriteComplete(c); });
+    conn->setConnectionCallback([weakCo](const TcpConnectionPtr &c)
+                                {
+        CoConnectionPtr co = weakCo.lock();
+        if (co)
+            co->onConnection(c); });
+    return co;
+}
+
+CoConnection::CoConnection(const TcpConnectionPtr &conn)
+    : conn_(conn),
+      loop_(conn->getLoop()),
+      input_(conn->inputBuffer()),
+      closed_(!conn->connected()),
+      readBytes_(0)
+{
+}
+
+bool CoConnection::readable(size_t n, const std::string &delim) const
+{
+    if (delim.empty())
+        return input_->readableBytes() >= n;
+    const char *begin = input_->peek();
+    const char *end = begin + input_->readableBytes();
+    return std::search(begin, end, delim.begin(), delim.end()) != end;
+}
+
+void CoConnection::waitRead(std::coroutine_handle<> h, size_t n, const std::string &delim)
+{
+    reader_ = h;
+    readBytes_ = n;
+    readDelim_ = delim;
+}
+
+std::string CoConnection::takeRead(size_t n, const std::string &delim)
+{
+    if (delim.empty())
+        return input_->retrieveAsString(std::min(n, input_->readableBytes()));
+
+    const char *begin = input_->peek();
+    const char *end = begin + input_->readableBytes();
+    const char *pos = delim == "\r\n" ? input_->findCRLF() : std::search(begin, end, delim.begin(), delim.end());
+    if (pos == nullptr || pos == end)
+        return input_->retrieveAllString(); // 连接断开，分隔符不会再来了
+    std::string result(begin, pos);
+    input_->retrieve(pos - begin + delim.size());
+    return result;
+}
+
+bool CoConnection::startWrite(const StringPiece &data)
+{
+    if (closed_)
+        return true;
+    conn_->send(data.data(), data.size());
+    return conn_->pendingBytes() == 0;
+}
+
+void CoConnection::onMessage(const TcpConnectionPtr &, Buffer *, TimeStamp)
+{
+    // 数据留在接收缓冲区里，条件满足时才恢复读协程，由它自己取走
+    if (reader_ && readable(readBytes_, readDelim_))
+        std::exchange(reader_, nullptr).resume();
+}
+
+void CoConnection::onWriteComplete(const TcpConnectionPtr &conn)
+{
+    // 写完成回调是排队执行的，期间可能又有新的数据，确认发送缓冲区真的空了再恢复
+    if (writer_ && conn->pendingBytes() == 0)
+        std::exchange(writer_, nullptr).resume();
+}
+
+void CoConnection::onConnection(const TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+        return;
+    closed_ = true;
+    if (reader_)
+        std::exchange(reader_, nullptr).resume();
+    if (writer_)
+        std::exchange(writer_, nullptr).resume();
+}
+
+#endif
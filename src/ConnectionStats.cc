@@ -0,0 +1,64 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 10:02:44
+ * @LastEditTime: 2026-10-21 10:02:44
+ */
+#include "ConnectionStats.h"
+
+#include "LoopMetrics.h"
+
+ConnectionStats::Snapshot::Snapshot()
+    : bytesRead(0),
+      bytesWritten(0),
+      readCalls(0),
+      writeCalls(0),
+      partialWrites(0),
+      outputBytes(0),
+      peakOutputBytes(0),
+      ageNs(0),
+      firstByteNs(-1)
+{
+}
+
+ConnectionStats::ConnectionStats()
+    : bytesRead_(0),
+      bytesWritten_(0),
+      readCalls_(0),
+      writeCalls_(0),
+      partialWrites_(0),
+      outputBytes_(0),
+      peakOutputBytes_(0),
+      establishedAtNs_(nowNs()),
+      firstByteAtNs_(0)
+{
+}
+
+ConnectionStats::Snapshot ConnectionStats::snapshot() const
+{
+    Snapshot snap;
+    snap.bytesRead = bytesRead_.load(std::memory_order_relaxed);
+    snap.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+    snap.readCalls = readCalls_.load(std::memory_order_relaxed);
+    snap.writeCalls = writeCalls_.load(std::memory_order_relaxed);
+    snap.partialWrites = partialWrites_.load(std::memory_order_relaxed);
+    snap.outputBytes = outputBytes_.load(std::memory_order_relaxed);
+    snap.peakOutputBytes = peakOutputBytes_.load(std::memory_order_relaxed);
+
+    uint64_t established = establishedAtNs_.load(std::memory_order_relaxed);
+    uint64_t firstByte = firstByteAtNs_.load(std::memory_order_relaxed);
+    uint64_t now = nowNs();
+    snap.ageNs = now > established ? now - established : 0;
+    if (firstByte != 0)
+        snap.firstByteNs = firstByte > established ? static_cast<int64_t>(firstByte - established) : 0;
+    return snap;
+}
+
+void ConnectionStats::recordEstablished()
+{
+    establishedAtNs_.store(nowNs(), std::memory_order_relaxed);
+}
+
+uint64_t ConnectionStats::nowNs()
+{
+    return LoopMetrics::nowNs();
+}
@@ -0,0 +1,217 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 14:03:26
+ * @LastEditTime: 2026-10-19 14:03:26
+ */
+#include "Connector.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+#include <algorithm>
+
+#include "Logger.h"
+#include "Channel.h"
+#include "EventLoop.h"
+#include "Socket.h"
+
+// 创建一个非阻塞的IO，family为AF_INET、AF_INET6或AF_UNIX
+static int createNonblocking(sa_family_t family)
+{
+    int sockfd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sockfd < 0)
+        LOG_FATAL("%s:%s:%d connect socket create err:%d \n", __FILE__, __FUNCTION__, __LINE__, errno);
+    return sockfd;
+}
+
+// 获取并清除socket上的错误
+static int getSocketError(int sockfd)
+{
+    int optval;
+    socklen_t optlen = sizeof(optval);
+    if (getsockopt(sockfd, SOL_SOCKET, SO_ERROR, &optval, &optlen) < 0)
+        return errno;
+    return optval;
+}
+
+// 自连接：连本机端口时，内核选的临时端口恰好等于目标端口，connect会成功连上自己
+static bool isSelfConnect(int sockfd)
+{
+    InetAddress local = Socket::getLocalAddr(sockfd);
+    if (local.family() == AF_UNIX)
+        return false;
+    InetAddress peer = Socket::getPeerAddr(sockfd);
+    return local.toPort() == peer.toPort() && local.toIp() == peer.toIp();
+}
+
+const int Connector::kMaxRetryDelayMs;
+
+Connector::Connector(EventLoop *loop, const InetAddress &serverAddr)
+    : loop_(loop),
+      serverAddr_(serverAddr),
+      connect_(false),
+      state_(kDisconnected),
+      retryDelayMs_(kInitRetryDelayMs)
+{
+}
+
+Connector::~Connector()
+{
+    // 析构前必须已经stop，并且channel已经释放
+}
+
+void Connector::start()
+{
+    connect_ = true;
+    loop_->runInLoop(std::bind(&Connector::startInLoop, shared_from_this()));
+}
+
+void Connector::startInLoop()
+{
+    if (connect_)
+    {
+        connect();
+    }
+    else
+    {
+        LOG_DEBUG("Connector::startInLoop do not connect \n");
+    }
+}
+
+void Connector::stop()
+{
+    connect_ = false;
+    loop_->queueInLoop(std::bind(&Connector::stopInLoop, shared_from_this()));
+}
+
+void Connector::stopInLoop()
+{
+    loop_->cancel(retryTimer_);
+    if (state_ == kConnecting)
+    {
+        setState(kDisconnected);
+        int sockfd = removeAndResetChannel();
+        retry(sockfd); // connect_为false，retry只会关闭sockfd
+    }
+}
+
+void Connector::restart()
+{
+    setState(kDisconnected);
+    retryDelayMs_ = kInitRetryDelayMs;
+    connect_ = true;
+    startInLoop();
+}
+
+void Connector::connect()
+{
+    int sockfd = createNonblocking(serverAddr_.family());
+    int ret = ::connect(sockfd, serverAddr_.getSockAddr(), serverAddr_.getSockLen());
+    int savedErrno = (ret == 0) ? 0 : errno;
+    switch (savedErrno)
+    {
+    case 0:
+    case EINPROGRESS: // 非阻塞connect正在进行中
+    case EINTR:
+    case EISCONN:
+        connecting(sockfd);
+        break;
+
+    // 暂时性错误，稍后重试
+    case EAGAIN:
+    case EADDRINUSE:
+    case EADDRNOTAVAIL:
+    case ECONNREFUSED:
+    case ENETUNREACH:
+        retry(sockfd);
+        break;
+
+    // 地址错误、权限等不可恢复的错误，不再重试
+    default:
+        LOG_ERROR("%s:%s:%d connect error:%d \n", __FILE__, __FUNCTION__, __LINE__, savedErrno);
+        ::close(sockfd);
+        break;
+    }
+}
+
+void Connector::connecting(int sockfd)
+{
+    setState(kConnecting);
+    channel_.reset(new Channel(loop_, sockfd));
+    channel_->setWriteCallback(Channel::EventCallback::fromMethod<Connector, &Connector::handleWrite>(this));
+    channel_->setErrorCallback(Channel::EventCallback::fromMethod<Connector, &Connector::handleError>(this));
+    // connect完成(成功或失败)时sockfd变为可写
+    channel_->enableWriting();
+}
+
+int Connector::removeAndResetChannel()
+{
+    channel_->disableAll();
+    channel_->remove();
+    int sockfd = channel_->fd();
+    // 当前正处在Channel::HandlerEvent中，不能马上释放channel_，放到doPendingFunctors里释放
+    loop_->queueInLoop(std::bind(&Connector::resetChannel, shared_from_this()));
+    return sockfd;
+}
+
+void Connector::resetChannel()
+{
+    channel_.reset();
+}
+
+void Connector::handleWrite()
+{
+    if (state_ == kConnecting)
+    {
+        int sockfd = removeAndResetChannel();
+        int err = getSocketError(sockfd);
+        if (err)
+        {
+            LOG_ERROR("Connector::handleWrite - SO_ERROR = %d \n", err);
+            retry(sockfd);
+        }
+        else if (isSelfConnect(sockfd))
+        {
+            LOG_ERROR("Connector::handleWrite - Self connect \n");
+            retry(sockfd);
+        }
+        else
+        {
+            setState(kConnected);
+            if (connect_ && newConnectionCallback_)
+                newConnectionCallback_(sockfd); // sockfd的所有权交给TcpClient
+            else
+                ::close(sockfd);
+        }
+    }
+}
+
+void Connector::handleError()
+{
+    LOG_ERROR("Connector::handleError state=%d \n", static_cast<int>(state_));
+    if (state_ == kConnecting)
+    {
+        int sockfd = removeAndResetChannel();
+        LOG_ERROR("Connector::handleError - SO_ERROR = %d \n", getSocketError(sockfd));
+        retry(sockfd);
+    }
+}
+
+void Connector::retry(int sockfd)
+{
+    ::close(sockfd);
+    setState(kDisconnected);
+    if (connect_)
+    {
+        LOG_INFO("Connector::retry - Retry connecting to %s in %d milliseconds. \n",
+                 serverAddr_.toIpPort().c_str(), retryDelayMs_);
+        // 定时器持有Connector的shared_ptr，保证重连时Connector还活着
+        retryTimer_ = loop_->runAfter(retryDelayMs_ / 1000.0,
+                                      std::bind(&Connector::startInLoop, shared_from_this()));
+        retryDelayMs_ = std::min(retryDelayMs_ * 2, kMaxRetryDelayMs); // 指数退避
+    }
+    else
+    {
+        LOG_DEBUG("do not connect \n");
+    }
+}
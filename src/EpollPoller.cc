@@ -11,6 +11,7 @@
 
 #include "Logger.h"
 #include "Channel.h"
+#include "Probes.h"
 
 /* 下面三个常量值表示了一个channel的三种状态 */
 // channel未添加到poller中
@@ -125,6 +126,7 @@ TimeStamp EpollPoller::poll(int timeoutMs, ChannelList *activeChannels)
     // 等待事件发生
     int numEvents = epoll_wait(epollfd_, &*events_.begin(), static_cast<int>(events_.size()), timeoutMs);
     int saveErrno = errno;
+    MYMUDUO_PROBE2(poll_return, numEvents, timeoutMs);
     TimeStamp now(TimeStamp::now());
     if (numEvents > 0)
     {
@@ -8,11 +8,15 @@
 #include <sys/eventfd.h>
 #include <memory>
 #include <errno.h>
+#include <stdio.h>
 
 #include "Poller.h"
 #include "Channel.h"
 #include "Logger.h"
 #include "CurrentThread.h"
+#include "BlockPool.h"
+#include "TimerQueue.h"
+#include "Probes.h"
 
 //__thread是一个thread_local的机制，代表这个变量是这个线程独有的全局变量，而不是所有线程共有
 __thread EventLoop *t_loopInThisThread = nullptr; // 防止一个线程创建多个EventLoop
@@ -35,9 +39,12 @@ EventLoop::EventLoop() : looping_(false),
                          callingPendingFunctors_(false),
                          threadId_(CurrentThread::tid()),              // 获取当前线程的tid
                          poller_(Poller::newDefaultPoller(this)),      // 获取一个封装着控制epoll操作的对象
+                         timerQueue_(new TimerQueue(this)),            // 定时器队列，timerfd也注册在poller上
                          wakeupFd_(createEventfd()),                   // 生成一个eventfd，每个EventLoop对象，都会有自己的eventfd
                          wakeupChannel_(new Channel(this, wakeupFd_)), // 每个channel都要知道自己所属的eventloop
-                         currentActiveChannel_(nullptr)
+                         currentActiveChannel_(nullptr),
+                         connectionPool_(std::make_shared<BlockPool>()),
+                         slowCallbackNs_(0)
 {
     LOG_DEBUG("EventLoop created %p in thread %d \n", this, threadId_);
     if (t_loopInThisThread) // 如果当前线程已经绑定了某个EventLoop对象了，那么该线程就无法创建新的EventLoop对象了
@@ -45,7 +52,8 @@ EventLoop::EventLoop() : looping_(false),
     else
         t_loopInThisThread = this;
     // 一开始wakeupChannel_并不在事件循环中，在设置回调函数后才被事件循环所监听
-    wakeupChannel_->setReadCallback(std::bind(&EventLoop::handleRead, this));
+    wakeupChannel_->setReadCallback(Channel::ReadEventCallback::fromMethod<EventLoop, &EventLoop::handleRead>(this));
+    wakeupChannel_->setName("EventLoop::wakeup");
     wakeupChannel_->enableReading(); // 每一个EventLoop都将监听wakeupChannel的EpollIN读事件了。
     // mainReactor通过给wakeupFd_给sbureactor写东西。
 }
@@ -58,7 +66,7 @@ EventLoop::~EventLoop()
     t_loopInThisThread = nullptr;
 }
 
-void EventLoop::handleRead()
+void EventLoop::handleRead(TimeStamp /*receiveTime*/)
 {
     uint64_t one = 1;
     ssize_t n = read(wakeupFd_, &one, sizeof(one)); // mainReactor给subreactor发消息，subReactor通过wakeupFd_感知。
@@ -78,12 +86,28 @@ void EventLoop::loop()
         activeChannels_.clear();
 
         // 监听两类fd，一个是client的fd，一个是wakeupfd，用于mainloop和subloop的通信
+        uint64_t pollStart = LoopMetrics::nowNs();
+        metrics_.setBusySince(0);
         pollReturnTime_ = poller_->poll(kPollTimeMs, &activeChannels_); // 此时activeChannels已经填好了事件发生的channel
+        uint64_t handleStart = LoopMetrics::nowNs();
+        metrics_.setBusySince(handleStart);
+        metrics_.recordPoll(static_cast<int>(activeChannels_.size()), handleStart - pollStart);
         for (Channel *channel : activeChannels_)
         {
             // Poller监听哪些channel发生事件了，然后上报（通过activeChannels）给EventLoop，通知channel处理相应事件
+            if (slowCallbackNs_ == 0)
+            {
+                channel->HandlerEvent(pollReturnTime_);
+                continue;
+            }
+            // 分发期间channel不会被析构（见Channel::HandlerEvent），分发结束后还可以读它的名字
+            uint64_t start = LoopMetrics::nowNs();
             channel->HandlerEvent(pollReturnTime_);
+            uint64_t elapsed = LoopMetrics::nowNs() - start;
+            if (elapsed >= slowCallbackNs_)
+                reportSlowCallback("event", channel, nullptr, elapsed);
         }
+        metrics_.recordHandleEvents(LoopMetrics::nowNs() - handleStart);
 
         doPendingFunctors(); // 执行当前EventLoop事件循环需要处理的回调操作。
     }
@@ -99,7 +123,7 @@ void EventLoop::quit()
         wakeup();
 }
 
-void EventLoop::runInLoop(Functor cb)
+void EventLoop::runInLoop(Functor cb, const char *tag)
 {
     // 保证了调用这个cb一定是在其EventLoop线程中被调用。
     if (isInLoopThread())
@@ -107,14 +131,15 @@ void EventLoop::runInLoop(Functor cb)
         cb();
     else
         // 否则调用 queueInLoop 函数
-        queueInLoop(cb);
+        queueInLoop(cb, tag);
 }
 
-void EventLoop::queueInLoop(Functor cb)
+void EventLoop::queueInLoop(Functor cb, const char *tag)
 {
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        pendingFunctors_.emplace_back(cb);
+        pendingFunctors_.push_back(PendingFunctor{std::move(cb), tag});
+        metrics_.setPendingDepth(pendingFunctors_.size());
     }
     // 唤醒相应的，需要执行上面回调操作的loop线程
     // || callingPendingFunctors_的意思是：当前loop正在执行回调，但是loop又有了新的回调
@@ -126,26 +151,89 @@ void EventLoop::queueInLoop(Functor cb)
 void EventLoop::wakeup()
 {
     // 想wakeupFd_中写，触发写事件，马上执行doPendingFunctors
+    metrics_.recordWakeup();
     uint64_t one = 1;
     ssize_t n = write(wakeupFd_, &one, sizeof(one));
     if (n != sizeof(n))
         LOG_ERROR("EventLoop::wakeup() writes %lu bytes instead of 8 \n", n);
 }
 
+TimerId EventLoop::runAt(TimeStamp time, TimerCallback cb)
+{
+    return timerQueue_->addTimer(std::move(cb), time, 0.0);
+}
+
+TimerId EventLoop::runAfter(double delay, TimerCallback cb)
+{
+    return runAt(addTime(TimeStamp::now(), delay), std::move(cb));
+}
+
+TimerId EventLoop::runEvery(double interval, TimerCallback cb)
+{
+    return timerQueue_->addTimer(std::move(cb), addTime(TimeStamp::now(), interval), interval);
+}
+
+void EventLoop::cancel(TimerId timerId)
+{
+    timerQueue_->cancel(timerId);
+}
+
 void EventLoop::updateChannel(Channel *channel) { poller_->updateChannel(channel); }
 void EventLoop::removeChannel(Channel *channel) { poller_->removeChannel(channel); }
 bool EventLoop::hasChannel(Channel *channel) { poller_->hasChannel(channel); }
 
 void EventLoop::doPendingFunctors()
 {
-    std::vector<Functor> functors;
+    MYMUDUO_PROBE(pending_functors_begin);
+    uint64_t start = LoopMetrics::nowNs();
+    std::vector<PendingFunctor> functors;
     callingPendingFunctors_ = true;
     {
         std::unique_lock<std::mutex> lock(mutex_);
         // 这里交换避免频繁触发锁，更效率
         functors.swap(pendingFunctors_); // 这里的swap其实只是交换的vector对象指向的内存空间的指针而已。
+        metrics_.setPendingDepth(0);
+    }
+    if (slowCallbackNs_ == 0)
+    {
+        for (const PendingFunctor &pending : functors)
+            pending.functor();
+    }
+    else
+    {
+        for (const PendingFunctor &pending : functors)
+        {
+            uint64_t begin = LoopMetrics::nowNs();
+            pending.functor();
+            uint64_t elapsed = LoopMetrics::nowNs() - begin;
+            if (elapsed >= slowCallbackNs_)
+                reportSlowCallback("functor", nullptr, pending.tag, elapsed);
+        }
     }
-    for (const Functor &functor : functors)
-        functor();
     callingPendingFunctors_ = false;
-}
\ No newline at end of file
+    metrics_.recordPendingFunctors(functors.size(), LoopMetrics::nowNs() - start);
+    MYMUDUO_PROBE1(pending_functors_end, functors.size());
+}
+
+void EventLoop::setSlowCallbackThreshold(double thresholdMs, SlowCallbackHandler handler)
+{
+    slowCallbackNs_ = thresholdMs > 0 ? static_cast<uint64_t>(thresholdMs * 1000000) : 0;
+    slowCallbackHandler_ = std::move(handler);
+}
+
+void EventLoop::reportSlowCallback(const char *kind, const Channel *channel, const char *tag, uint64_t ns)
+{
+    metrics_.recordSlowCallback();
+    char buf[32] = {0};
+    const char *name = buf;
+    if (channel && channel->name())
+        name = channel->name();
+    else if (channel)
+        snprintf(buf, sizeof(buf), "fd=%d", channel->fd());
+    else
+        name = tag ? tag : "untagged"; // 没有传tag的functor无法知道属于谁
+    if (slowCallbackHandler_)
+        slowCallbackHandler_(kind, name, ns / 1e6);
+    else
+        LOG_ERROR("EventLoop %p slow %s callback [%s] took %.3f ms \n", this, kind, name, ns / 1e6);
+}
@@ -6,6 +6,7 @@
 
 #include "EventLoopThreadPool.h"
 #include "EventLoopThread.h"
+#include "EventLoop.h"
 
 #include <memory>
 
@@ -20,7 +21,6 @@ EventLoopThreadPool::~EventLoopThreadPool() {}
 
 void EventLoopThreadPool::start(const ThreadInitCallback &cb)
 {
-    started_ = true;
     for (int i = 0; i < numThreads_; i++)
     {
         char buf[name_.size() + 32];
@@ -29,7 +29,8 @@ void EventLoopThreadPool::start(const ThreadInitCallback &cb)
         threads_.push_back(std::unique_ptr<EventLoopThread>(t));
         loops_.push_back(t->startLoop());
     }
-    if (numThreads_ == 0)
+    started_.store(true, std::memory_order_release);
+    if (numThreads_ == 0 && cb)
     {
         cb(baseLoop_);
     }
@@ -55,4 +56,14 @@ std::vector<EventLoop *> EventLoopThreadPool::getAllGroups()
         return std::vector<EventLoop *>{baseLoop_};
     else
         return loops_;
-}
\ No newline at end of file
+}
+
+LoopMetrics::Snapshot EventLoopThreadPool::metricsSnapshot()
+{
+    LoopMetrics::Snapshot total;
+    if (!started_.load(std::memory_order_acquire))
+        return total;
+    for (EventLoop *loop : getAllGroups())
+        total += loop->metrics().snapshot();
+    return total;
+}
@@ -0,0 +1,273 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:06:15
+ * @LastEditTime: 2026-10-19 19:06:15
+ */
+#include "HttpParser.h"
+#include "Buffer.h"
+
+#include <string.h>
+#include <strings.h>
+
+namespace
+{
+    struct MethodName
+    {
+        const char *name;
+        size_t len;
+        HttpRequest::Method method;
+    };
+
+    const MethodName kMethods[] = {
+        {"GET", 3, HttpRequest::kGet},
+        {"POST", 4, HttpRequest::kPost},
+        {"HEAD", 4, HttpRequest::kHead},
+        {"PUT", 3, HttpRequest::kPut},
+        {"DELETE", 6, HttpRequest::kDelete},
+        {"OPTIONS", 7, HttpRequest::kOptions},
+        {"PATCH", 5, HttpRequest::kPatch},
+    };
+
+    bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+    bool equalsIgnoreCase(const char *begin, const char *end, const char *s)
+    {
+        size_t len = ::strlen(s);
+        return static_cast<size_t>(end - begin) == len && ::strncasecmp(begin, s, len) == 0;
+    }
+}
+
+HttpParser::HttpParser()
+{
+    reset();
+}
+
+void HttpParser::reset()
+{
+    state_ = kExpectRequestLine;
+    pos_ = 0;
+    errorCode_ = 0;
+    contentLength_ = 0;
+    method_ = path_ = query_ = body_ = Span{0, 0};
+    fields_.clear(); // 保留容量，下一个请求不用重新分配
+    request_.method_ = HttpRequest::kInvalid;
+    request_.version_ = HttpRequest::kUnknown;
+}
+
+HttpParser::Result HttpParser::fail(int code)
+{
+    errorCode_ = code;
+    return kError;
+}
+
+HttpParser::Result HttpParser::parse(const Buffer *buf, TimeStamp receiveTime)
+{
+    if (state_ == kGotAll)
+        return kComplete;
+
+    const char *base = buf->peek();
+    const char *end = base + buf->readableBytes();
+
+    while (state_ == kExpectRequestLine || state_ == kExpectHeaders)
+    {
+        const char *begin = base + pos_;
+        const char *eol = buf->findEOL(begin);
+        if (eol == nullptr)
+        {
+            if (static_cast<size_t>(end - base) > kMaxHeaderBytes)
+                return fail(431);
+            return kIncomplete;
+        }
+        pos_ = eol + 1 - base;
+        if (pos_ > kMaxHeaderBytes)
+            return fail(431);
+        const char *lineEnd = (eol > begin && eol[-1] == '\r') ? eol - 1 : eol;
+
+        if (state_ == kExpectRequestLine)
+        {
+            // RFC 7230 3.5: 请求行之前的空行应当忽略
+            if (lineEnd == begin)
+                continue;
+            if (!parseRequestLine(base, begin, lineEnd))
+                return kError;
+            state_ = kExpectHeaders;
+        }
+        else if (lineEnd == begin)
+        {
+            // 空行，首部结束
+            if (!processHeaders(base))
+                return kError;
+            body_ = Span{static_cast<uint32_t>(pos_), static_cast<uint32_t>(contentLength_)};
+            state_ = kExpectBody;
+        }
+        else if (!parseHeaderLine(base, begin, lineEnd))
+        {
+            return kError;
+        }
+    }
+
+    if (state_ == kExpectBody)
+    {
+        if (static_cast<size_t>(end - base) < pos_ + contentLength_)
+            return kIncomplete;
+        pos_ += contentLength_;
+        state_ = kGotAll;
+    }
+
+    buildRequest(base, receiveTime);
+    return kComplete;
+}
+
+void HttpParser::consume(Buffer *buf)
+{
+    if (state_ == kGotAll)
+        buf->retrieve(pos_);
+    reset();
+}
+
+bool HttpParser::parseRequestLine(const char *base, const char *begin, const char *end)
+{
+    // 方法 SP 请求目标 SP 版本
+    const char *space = static_cast<const char *>(::memchr(begin, ' ', end - begin));
+    if (space == nullptr)
+    {
+        errorCode_ = 400;
+        return false;
+    }
+    method_ = Span{static_cast<uint32_t>(begin - base), static_cast<uint32_t>(space - begin)};
+    for (const MethodName &m : kMethods)
+    {
+        if (m.len == method_.len && ::memcmp(begin, m.name, m.len) == 0)
+        {
+            request_.method_ = m.method;
+            break;
+        }
+    }
+    if (request_.method_ == HttpRequest::kInvalid)
+    {
+        errorCode_ = 501;
+        return false;
+    }
+
+    const char *target = space + 1;
+    space = static_cast<const char *>(::memchr(target, ' ', end - target));
+    if (space == nullptr || space == target)
+    {
+        errorCode_ = 400;
+        return false;
+    }
+    const char *question = static_cast<const char *>(::memchr(target, '?', space - target));
+    if (question != nullptr)
+    {
+        path_ = Span{static_cast<uint32_t>(target - base), static_cast<uint32_t>(question - target)};
+        query_ = Span{static_cast<uint32_t>(question + 1 - base), static_cast<uint32_t>(space - question - 1)};
+    }
+    else
+    {
+        path_ = Span{static_cast<uint32_t>(target - base), static_cast<uint32_t>(space - target)};
+    }
+
+    const char *version = space + 1;
+    if (end - version != 8 || ::memcmp(version, "HTTP/1.", 7) != 0)
+    {
+        errorCode_ = (end - version > 5 && ::memcmp(version, "HTTP/", 5) == 0) ? 505 : 400;
+        return false;
+    }
+    if (version[7] == '1')
+        request_.version_ = HttpRequest::kHttp11;
+    else if (version[7] == '0')
+        request_.version_ = HttpRequest::kHttp10;
+    else
+    {
+        errorCode_ = 505;
+        return false;
+    }
+    return true;
+}
+
+bool HttpParser::parseHeaderLine(const char *base, const char *begin, const char *end)
+{
+    // 字段名: OWS 值 OWS，不支持已经废弃的折行写法
+    const char *colon = static_cast<const char *>(::memchr(begin, ':', end - begin));
+    if (colon == nullptr || colon == begin || isSpace(*begin) || isSpace(colon[-1]))
+    {
+        errorCode_ = 400;
+        return false;
+    }
+    const char *value = colon + 1;
+    while (value < end && isSpace(*value))
+        ++value;
+    const char *valueEnd = end;
+    while (valueEnd > value && isSpace(valueEnd[-1]))
+        --valueEnd;
+
+    Field field;
+    field.name = Span{static_cast<uint32_t>(begin - base), static_cast<uint32_t>(colon - begin)};
+    field.value = Span{static_cast<uint32_t>(value - base), static_cast<uint32_t>(valueEnd - value)};
+    fields_.push_back(field);
+    return true;
+}
+
+bool HttpParser::processHeaders(const char *base)
+{
+    bool seenContentLength = false;
+    for (const Field &field : fields_)
+    {
+        const char *name = base + field.name.offset;
+        const char *nameEnd = name + field.name.len;
+        const char *value = base + field.value.offset;
+        const char *valueEnd = value + field.value.len;
+        if (equalsIgnoreCase(name, nameEnd, "Content-Length"))
+        {
+            if (value == valueEnd)
+            {
+                errorCode_ = 400;
+                return false;
+            }
+            size_t len = 0;
+            for (const char *p = value; p < valueEnd; ++p)
+            {
+                if (*p < '0' || *p > '9')
+                {
+                    errorCode_ = 400;
+                    return false;
+                }
+                len = len * 10 + (*p - '0');
+                if (len > kMaxBodyBytes)
+                {
+                    errorCode_ = 413;
+                    return false;
+                }
+            }
+            // 多个Content-Length的值不一致时，前置代理和这里可能按不同的长度切分请求（请求走私），直接拒绝
+            if (seenContentLength && len != contentLength_)
+            {
+                errorCode_ = 400;
+                return false;
+            }
+            seenContentLength = true;
+            contentLength_ = len;
+        }
+        else if (equalsIgnoreCase(name, nameEnd, "Transfer-Encoding"))
+        {
+            errorCode_ = 501;
+            return false;
+        }
+    }
+    return true;
+}
+
+void HttpParser::buildRequest(const char *base, TimeStamp receiveTime)
+{
+    request_.methodString_ = StringPiece(base + method_.offset, method_.len);
+    request_.path_ = StringPiece(base + path_.offset, path_.len);
+    request_.query_ = StringPiece(base + query_.offset, query_.len);
+    request_.body_ = StringPiece(base + body_.offset, body_.len);
+    request_.receiveTime_ = receiveTime;
+    request_.headers_.clear();
+    for (const Field &field : fields_)
+    {
+        request_.headers_.push_back(HttpRequest::Header(StringPiece(base + field.name.offset, field.name.len),
+                                                        StringPiece(base + field.value.offset, field.value.len)));
+    }
+}
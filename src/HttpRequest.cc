@@ -0,0 +1,56 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:05:40
+ * @LastEditTime: 2026-10-19 19:05:40
+ */
+#include "HttpRequest.h"
+
+#include <strings.h>
+
+// 不区分大小写地比较
+static bool equalsIgnoreCase(const StringPiece &a, const StringPiece &b)
+{
+    return a.size() == b.size() && ::strncasecmp(a.data(), b.data(), a.size()) == 0;
+}
+
+// value是否包含token，不区分大小写，用于Connection这类逗号分隔的首部
+static bool containsToken(const StringPiece &value, const StringPiece &token)
+{
+    const char *p = value.begin();
+    while (p < value.end())
+    {
+        while (p < value.end() && (*p == ' ' || *p == '\t' || *p == ','))
+            ++p;
+        const char *start = p;
+        while (p < value.end() && *p != ',')
+            ++p;
+        const char *end = p;
+        while (end > start && (end[-1] == ' ' || end[-1] == '\t'))
+            --end;
+        if (equalsIgnoreCase(StringPiece(start, end - start), token))
+            return true;
+    }
+    return false;
+}
+
+StringPiece HttpRequest::getHeader(const StringPiece &field) const
+{
+    for (const Header &header : headers_)
+    {
+        if (equalsIgnoreCase(header.first, field))
+            return header.second;
+    }
+    return StringPiece();
+}
+
+bool HttpRequest::hasHeaderToken(const StringPiece &field, const StringPiece &token) const
+{
+    return containsToken(getHeader(field), token);
+}
+
+bool HttpRequest::keepAlive() const
+{
+    if (version_ == kHttp11)
+        return !hasHeaderToken("Connection", "close");
+    return hasHeaderToken("Connection", "keep-alive");
+}
@@ -0,0 +1,160 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:23:10
+ * @LastEditTime: 2026-10-19 19:23:10
+ */
+#include "HttpResponse.h"
+#include "Buffer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+HttpResponse::HttpResponse(Buffer *output, bool closeConnection, bool headRequest)
+    : output_(output),
+      statusCode_(k200Ok),
+      closeConnection_(closeConnection),
+      headRequest_(headRequest),
+      state_(kStatusLine)
+{
+}
+
+void HttpResponse::setStatusCode(int code)
+{
+    if (state_ == kStatusLine)
+        statusCode_ = code;
+}
+
+const char *HttpResponse::statusMessage(int code)
+{
+    switch (code)
+    {
+    case k101SwitchingProtocols:
+        return "Switching Protocols";
+    case k200Ok:
+        return "OK";
+    case k204NoContent:
+        return "No Content";
+    case k301MovedPermanently:
+        return "Moved Permanently";
+    case k304NotModified:
+        return "Not Modified";
+    case k400BadRequest:
+        return "Bad Request";
+    case k403Forbidden:
+        return "Forbidden";
+    case k404NotFound:
+        return "Not Found";
+    case k413PayloadTooLarge:
+        return "Payload Too Large";
+    case k426UpgradeRequired:
+        return "Upgrade Required";
+    case k431HeaderFieldsTooLarge:
+        return "Request Header Fields Too Large";
+    case k500InternalServerError:
+        return "Internal Server Error";
+    case k501NotImplemented:
+        return "Not Implemented";
+    case k503ServiceUnavailable:
+        return "Service Unavailable";
+    case k505VersionNotSupported:
+        return "HTTP Version Not Supported";
+    default:
+        return "Unknown";
+    }
+}
+
+void HttpResponse::writeStatusLine()
+{
+    char buf[64];
+    int n = snprintf(buf, sizeof buf, "HTTP/1.1 %d ", statusCode_);
+    output_->append(buf, n);
+    output_->append(statusMessage(statusCode_), strlen(statusMessage(statusCode_)));
+    output_->append("\r\n", 2);
+    state_ = kHeaders;
+}
+
+void HttpResponse::addHeader(const StringPiece &field, const StringPiece &value)
+{
+    if (state_ == kStatusLine)
+        writeStatusLine();
+    if (state_ != kHeaders)
+        return;
+    output_->append(field.data(), field.size());
+    output_->append(": ", 2);
+    output_->append(value.data(), value.size());
+    output_->append("\r\n", 2);
+}
+
+void HttpResponse::endHeaders()
+{
+    if (statusCode_ == k101SwitchingProtocols)
+        output_->append("Connection: Upgrade\r\n\r\n", 23);
+    else if (closeConnection_)
+        output_->append("Connection: close\r\n\r\n", 21);
+    else
+        output_->append("Connection: Keep-Alive\r\n\r\n", 26);
+}
+
+void HttpResponse::setBody(const StringPiece &body)
+{
+    if (state_ == kStatusLine)
+        writeStatusLine();
+    if (state_ != kHeaders)
+        return;
+    if (statusCode_ == k101SwitchingProtocols)
+    {
+        endHeaders();
+        state_ = kFinished;
+        return;
+    }
+    if (statusCode_ != k204NoContent)
+    {
+        char buf[48];
+        int n = snprintf(buf, sizeof buf, "Content-Length: %zu\r\n", body.size());
+        output_->append(buf, n);
+    }
+    endHeaders();
+    if (bodyAllowed())
+        output_->append(body.data(), body.size());
+    state_ = kFinished;
+}
+
+void HttpResponse::beginChunked()
+{
+    if (state_ == kStatusLine)
+        writeStatusLine();
+    if (state_ != kHeaders)
+        return;
+    if (statusCode_ != k204NoContent)
+        output_->append("Transfer-Encoding: chunked\r\n", 28);
+    endHeaders();
+    state_ = kChunked;
+}
+
+void HttpResponse::writeChunk(const StringPiece &data)
+{
+    if (state_ != kChunked || data.empty() || !bodyAllowed())
+        return;
+    char buf[24];
+    int n = snprintf(buf, sizeof buf, "%zx\r\n", data.size());
+    output_->append(buf, n);
+    output_->append(data.data(), data.size());
+    output_->append("\r\n", 2);
+}
+
+void HttpResponse::endChunked()
+{
+    if (state_ != kChunked)
+        return;
+    if (bodyAllowed())
+        output_->append("0\r\n\r\n", 5);
+    state_ = kFinished;
+}
+
+void HttpResponse::finish()
+{
+    if (state_ == kChunked)
+        endChunked();
+    else if (state_ != kFinished)
+        setBody(StringPiece());
+}
@@ -0,0 +1,74 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 19:35:30
+ * @LastEditTime: 2026-10-19 19:35:30
+ */
+#include "HttpServer.h"
+#include "HttpParser.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "TcpConnection.h"
+#include "Logger.h"
+
+using namespace std::placeholders;
+
+// 默认的请求处理：全部返回404
+static void defaultHttpCallback(const HttpRequest &, HttpResponse *resp)
+{
+    resp->setStatusCode(HttpResponse::k404NotFound);
+    resp->setBody("Not Found");
+}
+
+HttpServer::HttpServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &name, TcpServer::Option option)
+    : server_(loop, listenAddr, name, option),
+      httpCallback_(defaultHttpCallback)
+{
+    server_.setConnectionCallback(std::bind(&HttpServer::onConnection, this, _1));
+    server_.setMessageCallback(std::bind(&HttpServer::onMessage, this, _1, _2, _3));
+}
+
+void HttpServer::onConnection(const TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+        conn->setContext(std::make_shared<HttpParser>());
+}
+
+void HttpServer::onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    HttpParser *parser = static_cast<HttpParser *>(conn->getContext().get());
+    if (parser == nullptr || !conn->connected())
+    {
+        // 已经决定关闭的连接，丢弃后续的请求
+        buf->retrieveAll();
+        return;
+    }
+
+    bool close = false;
+    while (!close)
+    {
+        HttpParser::Result result = parser->parse(buf, receiveTime);
+        if (result == HttpParser::kIncomplete)
+            break;
+        if (result == HttpParser::kError)
+        {
+            LOG_ERROR("%s bad request from %s, status %d", __FUNCTION__, conn->name().c_str(), parser->errorCode());
+            HttpResponse response(conn->outputBuffer(), true);
+            response.setStatusCode(parser->errorCode());
+            response.setBody(HttpResponse::statusMessage(parser->errorCode()));
+            buf->retrieveAll();
+            close = true;
+            break;
+        }
+
+        const HttpRequest &request = parser->request();
+        HttpResponse response(conn->outputBuffer(), !request.keepAlive(), request.method() == HttpRequest::kHead);
+        httpCallback_(request, &response);
+        response.finish();
+        close = response.closeConnection();
+        parser->consume(buf);
+    }
+
+    conn->flush(); // 这一批请求的响应合并成一次write
+    if (close)
+        conn->shutdown();
+}
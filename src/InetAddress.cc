@@ -6,37 +6,121 @@
 
 #include "InetAddress.h"
 
+#include <stddef.h>
 #include <strings.h>
 #include <string.h>
 
-InetAddress::InetAddress(const sockaddr_in &addr) : addr_(addr) {}
+InetAddress::InetAddress(const sockaddr_in &addr)
+{
+    setSockAddr(addr);
+}
+
+InetAddress::InetAddress(const sockaddr_in6 &addr)
+{
+    setSockAddr(reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+}
+
+InetAddress::InetAddress(const sockaddr *addr, socklen_t len)
+{
+    setSockAddr(addr, len);
+}
 
 InetAddress::InetAddress(uint16_t port, std::string ip)
 {
     bzero(&addr_, sizeof(addr_));
-    addr_.sin_family = AF_INET;
-    addr_.sin_port = htons(port);                  
-    addr_.sin_addr.s_addr = inet_addr(ip.c_str()); // inet_addr()用来将参数cp 所指的网络地址字符串转换成网络所使用的二进制数字
+    if (ip.find(':') != std::string::npos)
+    {
+        sockaddr_in6 *addr6 = reinterpret_cast<sockaddr_in6 *>(&addr_);
+        addr6->sin6_family = AF_INET6;
+        addr6->sin6_port = htons(port);
+        inet_pton(AF_INET6, ip.c_str(), &addr6->sin6_addr);
+        len_ = sizeof(sockaddr_in6);
+    }
+    else
+    {
+        sockaddr_in *addr4 = reinterpret_cast<sockaddr_in *>(&addr_);
+        addr4->sin_family = AF_INET;
+        addr4->sin_port = htons(port);
+        addr4->sin_addr.s_addr = inet_addr(ip.c_str()); // inet_addr()用来将参数cp 所指的网络地址字符串转换成网络所使用的二进制数字
+        len_ = sizeof(sockaddr_in);
+    }
+}
+
+InetAddress InetAddress::fromUnixPath(const std::string &path)
+{
+    sockaddr_un addr;
+    bzero(&addr, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1); // 超长的路径会被截断
+    socklen_t len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + strlen(addr.sun_path) + 1);
+    return InetAddress(reinterpret_cast<const sockaddr *>(&addr), len);
+}
+
+void InetAddress::setSockAddr(const sockaddr_in &addr)
+{
+    setSockAddr(reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+}
+
+void InetAddress::setSockAddr(const sockaddr *addr, socklen_t len)
+{
+    if (len > sizeof(addr_))
+        len = sizeof(addr_);
+    bzero(&addr_, sizeof(addr_));
+    memcpy(&addr_, addr, len);
+    len_ = len;
 }
 
 std::string InetAddress::toIp() const
 {
-    char buf[64] = {0};
-    inet_ntop(AF_INET, &addr_.sin_addr, buf, sizeof(buf)); // 将数值格式转化为点分十进制的字符串ip地址格式
-    return buf;
+    char buf[INET6_ADDRSTRLEN] = {0};
+    switch (family())
+    {
+    case AF_INET:
+        // 将数值格式转化为点分十进制的字符串ip地址格式
+        inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in *>(&addr_)->sin_addr, buf, sizeof(buf));
+        return buf;
+    case AF_INET6:
+        inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6 *>(&addr_)->sin6_addr, buf, sizeof(buf));
+        return buf;
+    case AF_UNIX:
+        // 对端一般是未命名的socket，路径为空
+        if (len_ > offsetof(sockaddr_un, sun_path))
+            return reinterpret_cast<const sockaddr_un *>(&addr_)->sun_path;
+        return std::string();
+    default:
+        return std::string();
+    }
 }
 
 std::string InetAddress::toIpPort() const
 {
-    char buf[64] = {0};
-    inet_ntop(AF_INET, &addr_.sin_addr, buf, sizeof(buf));
-    size_t end = strlen(buf);
-    uint16_t port = ntohs(addr_.sin_port);
-    sprintf(buf + end, ":%u", port);
+    char buf[128] = {0};
+    switch (family())
+    {
+    case AF_INET:
+        snprintf(buf, sizeof(buf), "%s:%u", toIp().c_str(), toPort());
+        break;
+    case AF_INET6:
+        snprintf(buf, sizeof(buf), "[%s]:%u", toIp().c_str(), toPort());
+        break;
+    case AF_UNIX:
+        snprintf(buf, sizeof(buf), "unix:%s", toIp().c_str());
+        break;
+    default:
+        break;
+    }
     return buf;
 }
 
 uint16_t InetAddress::toPort() const
 {
-    return ntohs(addr_.sin_port);
-}
\ No newline at end of file
+    switch (family())
+    {
+    case AF_INET:
+        return ntohs(reinterpret_cast<const sockaddr_in *>(&addr_)->sin_port);
+    case AF_INET6:
+        return ntohs(reinterpret_cast<const sockaddr_in6 *>(&addr_)->sin6_port);
+    default:
+        return 0;
+    }
+}
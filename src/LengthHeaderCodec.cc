@@ -0,0 +1,55 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 18:42:11
+ * @LastEditTime: 2026-10-19 18:42:11
+ */
+#include "LengthHeaderCodec.h"
+#include "Buffer.h"
+#include "TcpConnection.h"
+#include "Logger.h"
+
+LengthHeaderCodec::LengthHeaderCodec(const FrameCallback &cb, size_t maxFrameLength)
+    : frameCallback_(cb),
+      maxFrameLength_(maxFrameLength)
+{
+}
+
+void LengthHeaderCodec::onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    // 一次读事件可能带来多条消息，循环切分直到剩下半包
+    while (buf->readableBytes() >= kHeaderLen)
+    {
+        const int32_t len = buf->peekInt32();
+        if (len < 0 || static_cast<size_t>(len) > maxFrameLength_)
+        {
+            LOG_ERROR("%s invalid frame length %d from %s", __FUNCTION__, len, conn->name().c_str());
+            conn->shutdown();
+            buf->retrieveAll();
+            break;
+        }
+        if (buf->readableBytes() < kHeaderLen + len)
+            break;
+
+        buf->retrieve(kHeaderLen);
+        frameCallback_(conn, StringPiece(buf->peek(), len), receiveTime);
+        buf->retrieve(len);
+    }
+}
+
+void LengthHeaderCodec::encode(Buffer *payload)
+{
+    payload->prependInt32(static_cast<int32_t>(payload->readableBytes()));
+}
+
+void LengthHeaderCodec::send(const TcpConnectionPtr &conn, Buffer *payload)
+{
+    encode(payload);
+    conn->send(payload);
+}
+
+void LengthHeaderCodec::send(const TcpConnectionPtr &conn, const StringPiece &message)
+{
+    Buffer buf(message.size());
+    buf.append(message.data(), message.size());
+    send(conn, &buf);
+}
@@ -0,0 +1,89 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 09:13:05
+ * @LastEditTime: 2026-10-21 09:13:05
+ */
+#include "LoopMetrics.h"
+
+#include <time.h>
+#include <algorithm>
+
+LoopMetrics::Snapshot::Snapshot()
+    : iterations(0),
+      pollTimeouts(0),
+      events(0),
+      peakEvents(0),
+      pollWaitNs(0),
+      handleEventsNs(0),
+      pendingFunctorsNs(0),
+      functors(0),
+      pendingDepth(0),
+      peakPendingDepth(0),
+      wakeups(0),
+      slowCallbacks(0),
+      busyNs(0)
+{
+}
+
+LoopMetrics::Snapshot &LoopMetrics::Snapshot::operator+=(const Snapshot &other)
+{
+    iterations += other.iterations;
+    pollTimeouts += other.pollTimeouts;
+    events += other.events;
+    peakEvents = std::max(peakEvents, other.peakEvents);
+    pollWaitNs += other.pollWaitNs;
+    handleEventsNs += other.handleEventsNs;
+    pendingFunctorsNs += other.pendingFunctorsNs;
+    functors += other.functors;
+    pendingDepth += other.pendingDepth;
+    peakPendingDepth = std::max(peakPendingDepth, other.peakPendingDepth);
+    wakeups += other.wakeups;
+    slowCallbacks += other.slowCallbacks;
+    busyNs = std::max(busyNs, other.busyNs);
+    return *this;
+}
+
+LoopMetrics::LoopMetrics()
+    : iterations_(0),
+      pollTimeouts_(0),
+      events_(0),
+      peakEvents_(0),
+      pollWaitNs_(0),
+      handleEventsNs_(0),
+      pendingFunctorsNs_(0),
+      functors_(0),
+      pendingDepth_(0),
+      peakPendingDepth_(0),
+      wakeups_(0),
+      slowCallbacks_(0),
+      busySinceNs_(0)
+{
+}
+
+LoopMetrics::Snapshot LoopMetrics::snapshot() const
+{
+    Snapshot snap;
+    snap.iterations = iterations_.load(std::memory_order_relaxed);
+    snap.pollTimeouts = pollTimeouts_.load(std::memory_order_relaxed);
+    snap.events = events_.load(std::memory_order_relaxed);
+    snap.peakEvents = peakEvents_.load(std::memory_order_relaxed);
+    snap.pollWaitNs = pollWaitNs_.load(std::memory_order_relaxed);
+    snap.handleEventsNs = handleEventsNs_.load(std::memory_order_relaxed);
+    snap.pendingFunctorsNs = pendingFunctorsNs_.load(std::memory_order_relaxed);
+    snap.functors = functors_.load(std::memory_order_relaxed);
+    snap.pendingDepth = pendingDepth_.load(std::memory_order_relaxed);
+    snap.peakPendingDepth = peakPendingDepth_.load(std::memory_order_relaxed);
+    snap.wakeups = wakeups_.load(std::memory_order_relaxed);
+    snap.slowCallbacks = slowCallbacks_.load(std::memory_order_relaxed);
+    uint64_t busySince = busySinceNs_.load(std::memory_order_relaxed);
+    uint64_t now = nowNs();
+    snap.busyNs = busySince != 0 && now > busySince ? now - busySince : 0;
+    return snap;
+}
+
+uint64_t LoopMetrics::nowNs()
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
@@ -0,0 +1,102 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 15:36:40
+ * @LastEditTime: 2026-10-21 15:36:40
+ */
+#include "LoopWatchdog.h"
+
+#include <chrono>
+
+#include "EventLoop.h"
+#include "EventLoopThreadPool.h"
+#include "LoopMetrics.h"
+#include "Logger.h"
+
+LoopWatchdog::LoopWatchdog(double stallMs, double checkIntervalMs)
+    : stallNs_(static_cast<uint64_t>(stallMs * 1000000)),
+      checkIntervalNs_(static_cast<uint64_t>((checkIntervalMs > 0 ? checkIntervalMs : stallMs / 4) * 1000000)),
+      stalls_(0),
+      thread_(std::bind(&LoopWatchdog::threadFunc, this), "LoopWatchdog"),
+      running_(false)
+{
+}
+
+LoopWatchdog::~LoopWatchdog()
+{
+    stop();
+}
+
+void LoopWatchdog::watch(const std::string &name, EventLoop *loop)
+{
+    loops_.push_back(std::make_pair(name, loop));
+}
+
+void LoopWatchdog::watch(const std::shared_ptr<EventLoopThreadPool> &pool)
+{
+    // 线程池的loops_在start中填写，没有加锁，不能在启动过程中从监控线程读取
+    if (!pool->started())
+    {
+        LOG_ERROR("LoopWatchdog::watch pool %s has not started, ignored \n", pool->name().c_str());
+        return;
+    }
+    std::vector<EventLoop *> loops = pool->getAllGroups();
+    for (size_t i = 0; i < loops.size(); ++i)
+        watch(pool->name() + "-" + std::to_string(i), loops[i]);
+}
+
+void LoopWatchdog::start()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (running_)
+            return;
+        running_ = true;
+    }
+    thread_.start();
+}
+
+void LoopWatchdog::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_)
+            return;
+        running_ = false;
+    }
+    cond_.notify_one();
+    thread_.join();
+}
+
+void LoopWatchdog::threadFunc()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_)
+    {
+        cond_.wait_for(lock, std::chrono::nanoseconds(checkIntervalNs_));
+        if (!running_)
+            break;
+        lock.unlock();
+        uint64_t now = LoopMetrics::nowNs();
+        for (const auto &item : loops_)
+            check(item.first, item.second, now);
+        lock.lock();
+    }
+}
+
+void LoopWatchdog::check(const std::string &name, EventLoop *loop, uint64_t now)
+{
+    uint64_t busySince = loop->metrics().busySinceNs();
+    if (busySince == 0 || now < busySince || now - busySince < stallNs_)
+        return;
+    uint64_t &reported = reported_[loop];
+    if (reported == busySince)
+        return; // 这次卡住已经报告过了
+    reported = busySince;
+    ++stalls_;
+
+    double stalledMs = (now - busySince) / 1e6;
+    if (stallCallback_)
+        stallCallback_(name, loop, stalledMs);
+    else
+        LOG_ERROR("LoopWatchdog: loop %s (%p) has not finished an iteration for %.1f ms \n", name.c_str(), loop, stalledMs);
+}
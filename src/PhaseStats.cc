@@ -0,0 +1,75 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 19:05:51
+ * @LastEditTime: 2026-10-20 19:05:51
+ */
+#include "PhaseStats.h"
+
+#include <time.h>
+
+namespace
+{
+    std::atomic<bool> g_enabled(false);
+    std::atomic<uint64_t> g_calls[PhaseStats::kNumPhases];
+    std::atomic<uint64_t> g_cpuNs[PhaseStats::kNumPhases];
+}
+
+void PhaseStats::setEnabled(bool on)
+{
+    g_enabled.store(on, std::memory_order_relaxed);
+}
+
+bool PhaseStats::enabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+PhaseStats::Snapshot PhaseStats::snapshot()
+{
+    Snapshot snap;
+    for (int i = 0; i < kNumPhases; ++i)
+    {
+        snap.calls[i] = g_calls[i].load(std::memory_order_relaxed);
+        snap.cpuNs[i] = g_cpuNs[i].load(std::memory_order_relaxed);
+    }
+    return snap;
+}
+
+void PhaseStats::reset()
+{
+    for (int i = 0; i < kNumPhases; ++i)
+    {
+        g_calls[i].store(0, std::memory_order_relaxed);
+        g_cpuNs[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+const char *PhaseStats::phaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case kAcceptorHandleRead:
+        return "Acceptor::handleRead";
+    case kNewConnection:
+        return "TcpServer::newConnection";
+    case kRemoveConnection:
+        return "TcpServer::removeConnectionInLoop";
+    case kConnectDestroyed:
+        return "TcpConnection::connectDestroyed";
+    default:
+        return "unknown";
+    }
+}
+
+uint64_t PhaseStats::threadCpuNs()
+{
+    timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+void PhaseStats::Scope::record(Phase phase, uint64_t ns)
+{
+    g_calls[phase].fetch_add(1, std::memory_order_relaxed);
+    g_cpuNs[phase].fetch_add(ns, std::memory_order_relaxed);
+}
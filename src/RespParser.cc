@@ -0,0 +1,212 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 22:40:30
+ * @LastEditTime: 2026-10-19 22:40:30
+ */
+#include "RespParser.h"
+#include "Buffer.h"
+#include "ByteScan.h"
+
+#include <string.h>
+#include <strings.h>
+
+bool RespCommand::is(const char *name) const
+{
+    size_t len = strlen(name);
+    return argc_ > 0 && args_[0].size() == len && ::strncasecmp(args_[0].data(), name, len) == 0;
+}
+
+RespParser::RespParser()
+    : pos_(0),
+      consumed_(0),
+      remainingArgs_(0),
+      bulkLen_(-1),
+      completedArgs_(0)
+{
+}
+
+bool RespParser::fail(const char *message)
+{
+    error_ = "Protocol error: ";
+    error_ += message;
+    return false;
+}
+
+int RespParser::parseNumberLine(const char *base, const char *end, int64_t *value)
+{
+    // base[pos_]是'*'或'$'前缀
+    const char *begin = base + pos_ + 1;
+    const char *crlf = ByteScan::findCRLF(begin, end);
+    if (crlf == nullptr)
+        return end - begin > 32 ? -1 : 0; // 合法的数字不会这么长
+    const char *p = begin;
+    bool negative = false;
+    if (p < crlf && *p == '-')
+    {
+        negative = true;
+        ++p;
+    }
+    if (p == crlf)
+        return -1;
+    int64_t n = 0;
+    for (; p < crlf; ++p)
+    {
+        if (*p < '0' || *p > '9' || n > (INT64_MAX - 9) / 10)
+            return -1;
+        n = n * 10 + (*p - '0');
+    }
+    *value = negative ? -n : n;
+    pos_ = crlf + 2 - base;
+    return 1;
+}
+
+void RespParser::parseInline(const char *base, const char *eol)
+{
+    const char *p = base + pos_;
+    const char *lineEnd = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+    size_t argc = 0;
+    while (p < lineEnd)
+    {
+        while (p < lineEnd && (*p == ' ' || *p == '\t'))
+            ++p;
+        const char *start = p;
+        while (p < lineEnd && *p != ' ' && *p != '\t')
+            ++p;
+        if (p > start)
+        {
+            spans_.push_back(Span{static_cast<size_t>(start - base), static_cast<size_t>(p - start)});
+            ++argc;
+        }
+    }
+    pos_ = eol + 1 - base;
+    consumed_ = pos_;
+    if (argc > 0) // 空行直接忽略
+    {
+        counts_.push_back(argc);
+        completedArgs_ = spans_.size();
+    }
+}
+
+int RespParser::parseArgs(const char *base, const char *end)
+{
+    while (remainingArgs_ > 0)
+    {
+        if (bulkLen_ < 0)
+        {
+            if (base + pos_ >= end)
+                return 0;
+            if (base[pos_] != '$')
+            {
+                fail("expected '$'");
+                return -1;
+            }
+            int64_t len = 0;
+            int result = parseNumberLine(base, end, &len);
+            if (result == 0)
+                return 0;
+            if (result < 0 || len < 0 || static_cast<uint64_t>(len) > kMaxBulkLength)
+            {
+                fail("invalid bulk length");
+                return -1;
+            }
+            bulkLen_ = len;
+        }
+        size_t len = static_cast<size_t>(bulkLen_);
+        if (static_cast<size_t>(end - base) < pos_ + len + 2)
+            return 0;
+        if (base[pos_ + len] != '\r' || base[pos_ + len + 1] != '\n')
+        {
+            fail("bulk string not terminated by CRLF");
+            return -1;
+        }
+        spans_.push_back(Span{pos_, len});
+        pos_ += len + 2;
+        bulkLen_ = -1;
+        --remainingArgs_;
+    }
+    return 1;
+}
+
+bool RespParser::parse(const Buffer *buf, std::vector<RespCommand> *commands)
+{
+    commands->clear();
+    const char *base = buf->peek();
+    const char *end = base + buf->readableBytes();
+    bool ok = true;
+
+    while (ok)
+    {
+        if (remainingArgs_ == 0)
+        {
+            // 下一条命令的开头
+            if (base + pos_ >= end)
+                break;
+            if (base[pos_] != '*')
+            {
+                const char *eol = ByteScan::findEOL(base + pos_, end);
+                if (eol == nullptr)
+                {
+                    if (static_cast<size_t>(end - base) - pos_ > kMaxInlineLength)
+                        ok = fail("too big inline request");
+                    break;
+                }
+                parseInline(base, eol);
+                continue;
+            }
+
+            int64_t count = 0;
+            int result = parseNumberLine(base, end, &count);
+            if (result == 0)
+                break;
+            if (result < 0 || count > kMaxMultiBulkLength)
+            {
+                ok = fail("invalid multibulk length");
+                break;
+            }
+            if (count <= 0)
+            {
+                // *0和*-1是空命令，Redis直接忽略
+                consumed_ = pos_;
+                continue;
+            }
+            remainingArgs_ = count;
+            bulkLen_ = -1;
+        }
+
+        int result = parseArgs(base, end);
+        if (result <= 0)
+        {
+            ok = result == 0;
+            break;
+        }
+        counts_.push_back(spans_.size() - completedArgs_);
+        completedArgs_ = spans_.size();
+        consumed_ = pos_;
+    }
+
+    // 出错时，错误之前的完整命令依然交给上层处理
+    // 全部解析完以后再生成StringPiece，args_不会再扩容，RespCommand中的指针保持有效
+    args_.clear();
+    for (size_t i = 0; i < completedArgs_; ++i)
+        args_.push_back(StringPiece(base + spans_[i].offset, spans_[i].len));
+    const StringPiece *args = args_.data();
+    for (size_t count : counts_)
+    {
+        commands->push_back(RespCommand(args, count));
+        args += count;
+    }
+    return ok;
+}
+
+void RespParser::consume(Buffer *buf)
+{
+    buf->retrieve(consumed_);
+    // 不完整命令已经解析出的参数，偏移量跟着Buffer的移动调整
+    spans_.erase(spans_.begin(), spans_.begin() + completedArgs_);
+    for (Span &span : spans_)
+        span.offset -= consumed_;
+    pos_ -= consumed_;
+    consumed_ = 0;
+    completedArgs_ = 0;
+    counts_.clear();
+}
@@ -0,0 +1,80 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 23:10:30
+ * @LastEditTime: 2026-10-19 23:10:30
+ */
+#include "RespServer.h"
+#include "RespWriter.h"
+#include "TcpConnection.h"
+#include "Logger.h"
+
+#include <memory>
+
+using namespace std::placeholders;
+
+namespace
+{
+    // 每个连接的状态，保存在TcpConnection的context中
+    struct RespContext
+    {
+        RespContext() : protocol(2) {}
+
+        RespParser parser;
+        std::vector<RespCommand> commands; // 复用容量，每批命令不用重新分配
+        int protocol;                      // 协议版本
+    };
+}
+
+RespServer::RespServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &name, TcpServer::Option option)
+    : server_(loop, listenAddr, name, option)
+{
+    server_.setConnectionCallback(std::bind(&RespServer::onConnection, this, _1));
+    server_.setMessageCallback(std::bind(&RespServer::onMessage, this, _1, _2, _3));
+}
+
+void RespServer::onConnection(const TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+        conn->setContext(std::make_shared<RespContext>());
+    if (connectionCallback_)
+        connectionCallback_(conn);
+}
+
+void RespServer::onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp)
+{
+    RespContext *context = static_cast<RespContext *>(conn->getContext().get());
+    if (context == nullptr || !conn->connected())
+    {
+        buf->retrieveAll();
+        return;
+    }
+
+    RespWriter writer(conn->outputBuffer(), context->protocol);
+    bool ok = context->parser.parse(buf, &context->commands);
+    if (!context->commands.empty())
+    {
+        if (batchCallback_)
+        {
+            batchCallback_(conn, context->commands, &writer);
+        }
+        else
+        {
+            for (size_t i = 0; i < context->commands.size(); ++i)
+                writer.writeError("ERR no command handler");
+        }
+        context->protocol = writer.protocol();
+    }
+    context->parser.consume(buf);
+
+    if (!ok)
+    {
+        // 协议错误之前的命令照常回复，然后报告错误并关闭连接，和Redis的行为一致
+        LOG_ERROR("%s %s from %s", __FUNCTION__, context->parser.error().c_str(), conn->name().c_str());
+        writer.writeError("ERR " + context->parser.error());
+        buf->retrieveAll();
+    }
+
+    conn->flush(); // 这一批命令的回复合并成一次write
+    if (!ok || writer.closeConnection())
+        conn->shutdown();
+}
@@ -0,0 +1,109 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 22:58:55
+ * @LastEditTime: 2026-10-19 22:58:55
+ */
+#include "RespWriter.h"
+#include "Buffer.h"
+
+#include <stdio.h>
+
+void RespWriter::writePrefixed(char prefix, int64_t value)
+{
+    char buf[32];
+    buf[0] = prefix;
+    int n = snprintf(buf + 1, sizeof(buf) - 1, "%lld\r\n", static_cast<long long>(value));
+    output_->append(buf, n + 1);
+}
+
+void RespWriter::writeSimpleString(const StringPiece &str)
+{
+    output_->ensureWritableBytes(str.size() + 3);
+    output_->append("+", 1);
+    output_->append(str.data(), str.size());
+    output_->append("\r\n", 2);
+}
+
+void RespWriter::writeError(const StringPiece &message)
+{
+    output_->ensureWritableBytes(message.size() + 3);
+    output_->append("-", 1);
+    output_->append(message.data(), message.size());
+    output_->append("\r\n", 2);
+}
+
+void RespWriter::writeInteger(int64_t value)
+{
+    writePrefixed(':', value);
+}
+
+void RespWriter::writeBulkString(const StringPiece &data)
+{
+    output_->ensureWritableBytes(data.size() + 16);
+    writePrefixed('$', static_cast<int64_t>(data.size()));
+    output_->append(data.data(), data.size());
+    output_->append("\r\n", 2);
+}
+
+void RespWriter::writeNull()
+{
+    if (protocol_ >= 3)
+        output_->append("_\r\n", 3);
+    else
+        output_->append("$-1\r\n", 5);
+}
+
+void RespWriter::writeNullArray()
+{
+    if (protocol_ >= 3)
+        output_->append("_\r\n", 3);
+    else
+        output_->append("*-1\r\n", 5);
+}
+
+void RespWriter::writeArrayHeader(size_t count)
+{
+    writePrefixed('*', static_cast<int64_t>(count));
+}
+
+void RespWriter::writeMapHeader(size_t count)
+{
+    if (protocol_ >= 3)
+        writePrefixed('%', static_cast<int64_t>(count));
+    else
+        writePrefixed('*', static_cast<int64_t>(count * 2));
+}
+
+void RespWriter::writeSetHeader(size_t count)
+{
+    writePrefixed(protocol_ >= 3 ? '~' : '*', static_cast<int64_t>(count));
+}
+
+void RespWriter::writePushHeader(size_t count)
+{
+    writePrefixed(protocol_ >= 3 ? '>' : '*', static_cast<int64_t>(count));
+}
+
+void RespWriter::writeDouble(double value)
+{
+    char buf[64];
+    int n = snprintf(buf, sizeof buf, "%.17g", value);
+    if (protocol_ >= 3)
+    {
+        output_->append(",", 1);
+        output_->append(buf, n);
+        output_->append("\r\n", 2);
+    }
+    else
+    {
+        writeBulkString(StringPiece(buf, n));
+    }
+}
+
+void RespWriter::writeBoolean(bool value)
+{
+    if (protocol_ >= 3)
+        output_->append(value ? "#t\r\n" : "#f\r\n", 4);
+    else
+        writeInteger(value ? 1 : 0);
+}
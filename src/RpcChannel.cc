@@ -0,0 +1,204 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:21:05
+ * @LastEditTime: 2026-10-20 09:21:05
+ */
+#include "RpcChannel.h"
+#include "EventLoop.h"
+#include "TcpConnection.h"
+#include "Logger.h"
+
+#include <endian.h>
+#include <string.h>
+
+using namespace std::placeholders;
+
+RpcChannel::RpcChannel(const TcpConnectionPtr &conn, std::shared_ptr<const RpcService> service)
+    : loop_(conn->getLoop()),
+      conn_(conn),
+      service_(std::move(service)),
+      codec_(std::bind(&RpcChannel::onFrame, this, _1, _2, _3)),
+      dispatching_(false),
+      nextRequestId_(1)
+{
+}
+
+RpcChannelPtr RpcChannel::get(const TcpConnectionPtr &conn)
+{
+    return std::static_pointer_cast<RpcChannel>(conn->getContext());
+}
+
+void RpcChannel::dispatchMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    RpcChannel *channel = static_cast<RpcChannel *>(conn->getContext().get());
+    if (channel)
+        channel->onMessage(conn, buf, receiveTime);
+    else
+        buf->retrieveAll();
+}
+
+const char *RpcChannel::statusName(Status status)
+{
+    switch (status)
+    {
+    case kOk:
+        return "ok";
+    case kNoMethod:
+        return "no method";
+    case kError:
+        return "error";
+    case kTimeout:
+        return "timeout";
+    case kDisconnected:
+        return "disconnected";
+    }
+    return "unknown";
+}
+
+void RpcChannel::call(uint32_t methodId, const StringPiece &request, const ResponseCallback &cb, double timeout)
+{
+    if (loop_->isInLoopThread())
+    {
+        callInLoop(methodId, request, cb, timeout);
+    }
+    else
+    {
+        // request可能在调用返回后就失效了，跨线程时拷贝一份
+        loop_->runInLoop(std::bind(&RpcChannel::callStringInLoop, shared_from_this(),
+                                   methodId, request.toString(), cb, timeout));
+    }
+}
+
+void RpcChannel::callStringInLoop(uint32_t methodId, const std::string &request, const ResponseCallback &cb, double timeout)
+{
+    callInLoop(methodId, request, cb, timeout);
+}
+
+void RpcChannel::callInLoop(uint32_t methodId, const StringPiece &request, const ResponseCallback &cb, double timeout)
+{
+    TcpConnectionPtr conn = conn_.lock();
+    if (!conn || !conn->connected())
+    {
+        // 不在call里同步回调，避免调用方在回调中重试导致递归
+        loop_->queueInLoop(std::bind(cb, kDisconnected, StringPiece()));
+        return;
+    }
+
+    const uint64_t requestId = nextRequestId_++;
+    PendingCall &call = pending_[requestId];
+    call.callback = cb;
+    call.hasTimer = timeout > 0.0;
+    if (call.hasTimer)
+    {
+        std::weak_ptr<RpcChannel> weakSelf(shared_from_this());
+        call.timer = loop_->runAfter(timeout, [weakSelf, requestId]()
+                                     {
+            RpcChannelPtr self = weakSelf.lock();
+            if (self)
+                self->onTimeout(requestId); });
+    }
+    writeFrame(requestId, methodId, kRequest, kOk, request);
+}
+
+void RpcChannel::onTimeout(uint64_t requestId)
+{
+    auto it = pending_.find(requestId);
+    if (it == pending_.end())
+        return;
+    ResponseCallback cb = std::move(it->second.callback);
+    pending_.erase(it);
+    cb(kTimeout, StringPiece());
+}
+
+void RpcChannel::onDisconnected()
+{
+    // 先整体换出来，回调中发起的新调用不会影响这次遍历
+    std::unordered_map<uint64_t, PendingCall> pending;
+    pending.swap(pending_);
+    for (auto &it : pending)
+    {
+        if (it.second.hasTimer)
+            loop_->cancel(it.second.timer);
+        it.second.callback(kDisconnected, StringPiece());
+    }
+}
+
+void RpcChannel::onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    dispatching_ = true;
+    codec_.onMessage(conn, buf, receiveTime);
+    dispatching_ = false;
+    conn->flush(); // 这次读事件中的同步应答合并成一次write
+}
+
+void RpcChannel::onFrame(const TcpConnectionPtr &conn, StringPiece frame, TimeStamp)
+{
+    if (frame.size() < kHeaderLen)
+    {
+        LOG_ERROR("%s short rpc frame (%zu bytes) from %s", __FUNCTION__, frame.size(), conn->name().c_str());
+        conn->shutdown();
+        return;
+    }
+
+    uint64_t requestId;
+    uint32_t methodId;
+    ::memcpy(&requestId, frame.data(), sizeof requestId);
+    ::memcpy(&methodId, frame.data() + 8, sizeof methodId);
+    requestId = be64toh(requestId);
+    methodId = be32toh(methodId);
+    const uint8_t type = static_cast<uint8_t>(frame[12]);
+    const uint8_t status = static_cast<uint8_t>(frame[13]);
+    frame.removePrefix(kHeaderLen);
+
+    if (type == kRequest)
+    {
+        RpcReply reply(shared_from_this(), loop_, requestId);
+        if (!service_ || !service_->dispatch(methodId, frame, reply))
+            sendResponse(requestId, kNoMethod, StringPiece());
+    }
+    else if (type == kResponse)
+    {
+        auto it = pending_.find(requestId);
+        if (it == pending_.end())
+            return; // 已经超时的调用，响应直接丢弃
+        ResponseCallback cb = std::move(it->second.callback);
+        if (it->second.hasTimer)
+            loop_->cancel(it->second.timer);
+        pending_.erase(it);
+        cb(status <= kError ? static_cast<Status>(status) : kError, frame);
+    }
+    else
+    {
+        LOG_ERROR("%s unknown rpc frame type %u from %s", __FUNCTION__, type, conn->name().c_str());
+        conn->shutdown();
+    }
+}
+
+void RpcChannel::sendResponse(uint64_t requestId, Status status, const StringPiece &payload)
+{
+    writeFrame(requestId, 0, kResponse, status, payload);
+}
+
+void RpcChannel::writeFrame(uint64_t requestId, uint32_t methodId, FrameType type, Status status, const StringPiece &payload)
+{
+    TcpConnectionPtr conn = conn_.lock();
+    if (!conn || !conn->connected())
+        return;
+
+    // 长度头和RPC头拼好一次写入，消息体直接拷进outputBuffer_，不经过临时Buffer
+    char header[LengthHeaderCodec::kHeaderLen + kHeaderLen];
+    const uint32_t len = htobe32(static_cast<uint32_t>(kHeaderLen + payload.size()));
+    const uint64_t id = htobe64(requestId);
+    const uint32_t method = htobe32(methodId);
+    ::memcpy(header, &len, sizeof len);
+    ::memcpy(header + 4, &id, sizeof id);
+    ::memcpy(header + 12, &method, sizeof method);
+    header[16] = static_cast<char>(type);
+    header[17] = static_cast<char>(status);
+
+    Buffer *output = conn->outputBuffer();
+    output->append(header, sizeof header);
+    output->append(payload.data(), payload.size());
+    if (!dispatching_)
+        conn->flush();
+}
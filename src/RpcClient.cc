@@ -0,0 +1,42 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:52:20
+ * @LastEditTime: 2026-10-20 09:52:20
+ */
+#include "RpcClient.h"
+#include "RpcChannel.h"
+#include "TcpConnection.h"
+
+using namespace std::placeholders;
+
+RpcClient::RpcClient(EventLoop *loop, const InetAddress &serverAddr, const std::string &name)
+    : client_(loop, serverAddr, name),
+      service_(std::make_shared<RpcService>())
+{
+    client_.setConnectionCallback(std::bind(&RpcClient::onConnection, this, _1));
+    client_.setMessageCallback(&RpcChannel::dispatchMessage);
+}
+
+void RpcClient::onConnection(const TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+    {
+        conn->setTcpNoDelay(true);
+        RpcChannelPtr channel = std::make_shared<RpcChannel>(conn, service_);
+        conn->setContext(channel);
+        std::unique_lock<std::mutex> lock(mutex_);
+        channel_ = channel;
+    }
+    else
+    {
+        RpcChannelPtr channel;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            channel.swap(channel_);
+        }
+        if (channel)
+            channel->onDisconnected();
+    }
+    if (connectionCallback_)
+        connectionCallback_(conn);
+}
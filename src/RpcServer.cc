@@ -0,0 +1,35 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:40:37
+ * @LastEditTime: 2026-10-20 09:40:37
+ */
+#include "RpcServer.h"
+#include "RpcChannel.h"
+#include "TcpConnection.h"
+
+using namespace std::placeholders;
+
+RpcServer::RpcServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &name, TcpServer::Option option)
+    : server_(loop, listenAddr, name, option),
+      service_(std::make_shared<RpcService>())
+{
+    server_.setConnectionCallback(std::bind(&RpcServer::onConnection, this, _1));
+    server_.setMessageCallback(&RpcChannel::dispatchMessage);
+}
+
+void RpcServer::onConnection(const TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+    {
+        conn->setTcpNoDelay(true); // 请求响应式的小消息，不能被Nagle算法攒着
+        conn->setContext(std::make_shared<RpcChannel>(conn, service_));
+    }
+    else
+    {
+        RpcChannelPtr channel = RpcChannel::get(conn);
+        if (channel)
+            channel->onDisconnected();
+    }
+    if (connectionCallback_)
+        connectionCallback_(conn);
+}
@@ -0,0 +1,69 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 09:12:48
+ * @LastEditTime: 2026-10-20 09:12:48
+ */
+#include "RpcService.h"
+#include "RpcChannel.h"
+#include "EventLoop.h"
+
+#include <string>
+
+void RpcReply::reply(const StringPiece &payload) const
+{
+    respond(RpcChannel::kOk, payload);
+}
+
+void RpcReply::fail(const StringPiece &message) const
+{
+    respond(RpcChannel::kError, message);
+}
+
+void RpcReply::respond(int status, const StringPiece &payload) const
+{
+    if (loop_->isInLoopThread())
+    {
+        RpcChannelPtr channel = channel_.lock();
+        if (channel)
+            channel->sendResponse(requestId_, static_cast<RpcChannel::Status>(status), payload);
+        return;
+    }
+
+    // 在工作线程中不lock通道，避免通道最后一个引用在工作线程中释放；到loop线程里再lock
+    std::weak_ptr<RpcChannel> weakChannel = channel_;
+    uint64_t requestId = requestId_;
+    std::string copy = payload.toString();
+    loop_->queueInLoop([weakChannel, requestId, status, copy]()
+                       {
+        RpcChannelPtr channel = weakChannel.lock();
+        if (channel)
+            channel->sendResponse(requestId, static_cast<RpcChannel::Status>(status), copy); });
+}
+
+void RpcService::registerMethod(uint32_t methodId, const Method &method, const Executor &executor)
+{
+    Entry &entry = methods_[methodId];
+    entry.method = method;
+    entry.executor = executor;
+}
+
+bool RpcService::dispatch(uint32_t methodId, const StringPiece &request, const RpcReply &reply) const
+{
+    auto it = methods_.find(methodId);
+    if (it == methods_.end())
+        return false;
+
+    const Entry &entry = it->second;
+    if (!entry.executor)
+    {
+        entry.method(request, reply);
+        return true;
+    }
+
+    // request指向接收缓冲区，交给别的线程之前要拷贝一份
+    std::shared_ptr<std::string> copy = std::make_shared<std::string>(request.data(), request.size());
+    Method method = entry.method;
+    entry.executor([method, copy, reply]()
+                   { method(StringPiece(*copy), reply); });
+    return true;
+}
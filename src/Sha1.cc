@@ -0,0 +1,98 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:02:30
+ * @LastEditTime: 2026-10-19 21:02:30
+ */
+#include "Sha1.h"
+
+#include <string.h>
+
+namespace Sha1
+{
+
+    static inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+    // 处理一个64字节的分组
+    static void processBlock(const uint8_t *block, uint32_t *h)
+    {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i)
+        {
+            w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+                   (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+                   (static_cast<uint32_t>(block[i * 4 + 2]) << 8) |
+                   static_cast<uint32_t>(block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 80; ++i)
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i)
+        {
+            uint32_t f, k;
+            if (i < 20)
+            {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            }
+            else if (i < 40)
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            }
+            else if (i < 60)
+            {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    void digest(const void *data, size_t len, uint8_t *digest)
+    {
+        uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+
+        size_t full = len / 64 * 64;
+        for (size_t i = 0; i < full; i += 64)
+            processBlock(p + i, h);
+
+        // 补位：0x80，然后补0直到长度模64余56，最后8字节是以位为单位的原始长度(大端)
+        uint8_t tail[128];
+        size_t rest = len - full;
+        memcpy(tail, p + full, rest);
+        tail[rest] = 0x80;
+        size_t tailLen = rest + 1 + 8 <= 64 ? 64 : 128;
+        memset(tail + rest + 1, 0, tailLen - rest - 1);
+        uint64_t bits = static_cast<uint64_t>(len) * 8;
+        for (int i = 0; i < 8; ++i)
+            tail[tailLen - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+        for (size_t i = 0; i < tailLen; i += 64)
+            processBlock(tail + i, h);
+
+        for (int i = 0; i < 5; ++i)
+        {
+            digest[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+            digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+            digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+            digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+        }
+    }
+
+}
@@ -22,7 +22,7 @@ Socket::~Socket()
 
 void Socket::bindAddress(const InetAddress &localaddr)
 {
-    if (0 != bind(sockfd_, (sockaddr *)localaddr.getSockAddr(), sizeof(sockaddr_in)))
+    if (0 != bind(sockfd_, localaddr.getSockAddr(), localaddr.getSockLen()))
     {
         LOG_FATAL("bind sockfd:%d fail \n", sockfd_);
     }
@@ -38,8 +38,9 @@ void Socket::listen()
 
 int Socket::accept(InetAddress *peeraddr)
 {
-    // 传进来的是个空的InetAddress对象，当accept成功了就给这个InetAddress对象设成功连接的sockaddr_in
-    sockaddr_in addr;
+    // 传进来的是个空的InetAddress对象，当accept成功了就给这个InetAddress对象设成功连接的地址
+    // 用sockaddr_storage接收，IPv4、IPv6和Unix域的地址都放得下
+    sockaddr_storage addr;
     socklen_t len = sizeof(addr);
     bzero(&addr, sizeof(addr));
     int connfd = accept4(sockfd_, (sockaddr *)&addr, &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
@@ -47,7 +48,7 @@ int Socket::accept(InetAddress *peeraddr)
     // 直到有东西可读或者可写为止。而对于非阻塞状态，如果没有东西可读，或者不可写，读写函数马上返回，而不会等待。
     if (connfd >= 0)
     {
-        peeraddr->setSockAddr(addr); // 给InetAddress对象设置sockaddr_in
+        peeraddr->setSockAddr((sockaddr *)&addr, len); // 给InetAddress对象设置地址
     }
     return connfd;
 }
@@ -83,3 +84,23 @@ void Socket::setKeepAlive(bool on)
     setsockopt(sockfd_, SOL_SOCKET, SO_KEEPALIVE, &optval, sizeof(optval));
     // TCP保活机制
 }
+
+InetAddress Socket::getLocalAddr(int sockfd)
+{
+    sockaddr_storage addr;
+    bzero(&addr, sizeof(addr));
+    socklen_t len = sizeof(addr);
+    if (getsockname(sockfd, (sockaddr *)&addr, &len) < 0)
+        LOG_ERROR("sockets::getLocalAddr");
+    return InetAddress((sockaddr *)&addr, len);
+}
+
+InetAddress Socket::getPeerAddr(int sockfd)
+{
+    sockaddr_storage addr;
+    bzero(&addr, sizeof(addr));
+    socklen_t len = sizeof(addr);
+    if (getpeername(sockfd, (sockaddr *)&addr, &len) < 0)
+        LOG_ERROR("sockets::getPeerAddr");
+    return InetAddress((sockaddr *)&addr, len);
+}
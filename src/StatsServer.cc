@@ -0,0 +1,269 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-21 11:21:02
+ * @LastEditTime: 2026-10-21 11:21:02
+ */
+#include "StatsServer.h"
+
+#include <stdio.h>
+#include <algorithm>
+
+#include "EventLoop.h"
+#include "EventLoopThreadPool.h"
+#include "TcpServer.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "LoopMetrics.h"
+#include "ConnectionStats.h"
+#include "Logger.h"
+
+using namespace std::placeholders;
+
+namespace
+{
+    // 每个loop导出的指标，seconds为true时把纳秒换成秒
+    struct LoopFamily
+    {
+        const char *name;
+        const char *type;
+        const char *help;
+        uint64_t LoopMetrics::Snapshot::*field;
+        bool seconds;
+    };
+
+    const LoopFamily kLoopFamilies[] = {
+        {"mymuduo_loop_iterations_total", "counter", "Event loop iterations.", &LoopMetrics::Snapshot::iterations, false},
+        {"mymuduo_loop_poll_timeouts_total", "counter", "Polls that returned without events.", &LoopMetrics::Snapshot::pollTimeouts, false},
+        {"mymuduo_loop_events_total", "counter", "Active channels handled.", &LoopMetrics::Snapshot::events, false},
+        {"mymuduo_loop_peak_events", "gauge", "Most active channels returned by a single poll.", &LoopMetrics::Snapshot::peakEvents, false},
+        {"mymuduo_loop_poll_wait_seconds_total", "counter", "Time blocked in epoll_wait.", &LoopMetrics::Snapshot::pollWaitNs, true},
+        {"mymuduo_loop_handle_events_seconds_total", "counter", "Time spent handling channel events.", &LoopMetrics::Snapshot::handleEventsNs, true},
+        {"mymuduo_loop_pending_functors_seconds_total", "counter", "Time spent running pending functors.", &LoopMetrics::Snapshot::pendingFunctorsNs, true},
+        {"mymuduo_loop_functors_total", "counter", "Pending functors run.", &LoopMetrics::Snapshot::functors, false},
+        {"mymuduo_loop_pending_functors", "gauge", "Functors currently queued.", &LoopMetrics::Snapshot::pendingDepth, false},
+        {"mymuduo_loop_peak_pending_functors", "gauge", "Most functors drained by a single doPendingFunctors.", &LoopMetrics::Snapshot::peakPendingDepth, false},
+        {"mymuduo_loop_wakeups_total", "counter", "Calls to EventLoop::wakeup.", &LoopMetrics::Snapshot::wakeups, false},
+        {"mymuduo_loop_slow_callbacks_total", "counter", "Callbacks over the slow-callback threshold.", &LoopMetrics::Snapshot::slowCallbacks, false},
+        {"mymuduo_loop_busy_seconds", "gauge", "Time the current iteration has been running, 0 while polling.", &LoopMetrics::Snapshot::busyNs, true},
+    };
+
+    // 每个服务器导出的连接统计，peak为true时取所有连接的最大值，否则求和
+    struct ConnectionFamily
+    {
+        const char *name;
+        const char *help;
+        uint64_t ConnectionStats::Snapshot::*field;
+        bool peak;
+    };
+
+    const ConnectionFamily kServerFamilies[] = {
+        {"mymuduo_server_bytes_read", "Bytes read by open connections.", &ConnectionStats::Snapshot::bytesRead, false},
+        {"mymuduo_server_bytes_written", "Bytes written by open connections.", &ConnectionStats::Snapshot::bytesWritten, false},
+        {"mymuduo_server_read_calls", "Read syscalls made by open connections.", &ConnectionStats::Snapshot::readCalls, false},
+        {"mymuduo_server_write_calls", "Write syscalls made by open connections.", &ConnectionStats::Snapshot::writeCalls, false},
+        {"mymuduo_server_partial_writes", "Incomplete writes made by open connections.", &ConnectionStats::Snapshot::partialWrites, false},
+        {"mymuduo_server_output_bytes", "Bytes waiting to be sent on open connections.", &ConnectionStats::Snapshot::outputBytes, false},
+        {"mymuduo_server_peak_output_bytes", "Largest pending output of any open connection.", &ConnectionStats::Snapshot::peakOutputBytes, true},
+    };
+
+    const ConnectionFamily kConnectionFamilies[] = {
+        {"mymuduo_connection_bytes_read", "Bytes read by the connection.", &ConnectionStats::Snapshot::bytesRead, false},
+        {"mymuduo_connection_bytes_written", "Bytes written by the connection.", &ConnectionStats::Snapshot::bytesWritten, false},
+        {"mymuduo_connection_partial_writes", "Incomplete writes made by the connection.", &ConnectionStats::Snapshot::partialWrites, false},
+        {"mymuduo_connection_output_bytes", "Bytes waiting to be sent.", &ConnectionStats::Snapshot::outputBytes, false},
+        {"mymuduo_connection_peak_output_bytes", "Peak bytes waiting to be sent.", &ConnectionStats::Snapshot::peakOutputBytes, false},
+    };
+
+    void appendHeader(std::string *out, const char *name, const char *type, const char *help)
+    {
+        out->append("# HELP ").append(name).append(" ").append(help).append("\n");
+        out->append("# TYPE ").append(name).append(" ").append(type).append("\n");
+    }
+
+    // 标签值中的反斜杠、双引号、换行需要转义
+    void appendLabel(std::string *out, const char *key, const std::string &value)
+    {
+        if (out->back() != '{')
+            out->push_back(',');
+        out->append(key).append("=\"");
+        for (char c : value)
+        {
+            if (c == '\\' || c == '"')
+                out->push_back('\\');
+            if (c == '\n')
+                out->append("\\n");
+            else
+                out->push_back(c);
+        }
+        out->push_back('"');
+    }
+
+    void appendValue(std::string *out, uint64_t value)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "} %llu\n", static_cast<unsigned long long>(value));
+        out->append(buf);
+    }
+
+    // 秒数保留到微秒
+    void appendSeconds(std::string *out, double seconds)
+    {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "} %.6f\n", seconds);
+        out->append(buf);
+    }
+
+    struct ServerConnections
+    {
+        std::string server;
+        TcpServer::ConnectionStatsList conns;
+    };
+}
+
+StatsServer::StatsServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &name)
+    : loop_(loop),
+      server_(loop, listenAddr, name),
+      topConnections_(0)
+{
+    server_.setHttpCallback(std::bind(&StatsServer::onRequest, this, _1, _2));
+}
+
+void StatsServer::addLoop(const std::string &name, EventLoop *loop)
+{
+    loops_.push_back(LoopSource{name, loop, nullptr});
+}
+
+void StatsServer::addThreadPool(const std::shared_ptr<EventLoopThreadPool> &pool)
+{
+    loops_.push_back(LoopSource{pool->name(), nullptr, pool});
+}
+
+void StatsServer::addServer(TcpServer *server)
+{
+    addThreadPool(server->threadPool());
+    if (server->getLoop() != loop_)
+    {
+        LOG_ERROR("StatsServer::addServer %s runs on another loop, connection stats are not exported", server->name().c_str());
+        return;
+    }
+    servers_.push_back(server);
+}
+
+void StatsServer::onRequest(const HttpRequest &request, HttpResponse *response)
+{
+    if (!(request.path() == "/metrics"))
+    {
+        response->setStatusCode(HttpResponse::k404NotFound);
+        response->setBody("Not Found");
+        return;
+    }
+    response->setContentType("text/plain; version=0.0.4");
+    response->setBody(render());
+}
+
+std::string StatsServer::render()
+{
+    // 先把所有快照读出来，再按指标分组输出：同一个指标的样本必须连续
+    std::vector<std::pair<std::string, LoopMetrics::Snapshot>> loops;
+    for (const LoopSource &source : loops_)
+    {
+        if (source.loop)
+        {
+            loops.push_back(std::make_pair(source.name, source.loop->metrics().snapshot()));
+            continue;
+        }
+        // 线程池可能正在其他线程中start，loop列表填完之前不读
+        if (!source.pool->started())
+            continue;
+        std::vector<EventLoop *> groups = source.pool->getAllGroups();
+        for (size_t i = 0; i < groups.size(); ++i)
+            loops.push_back(std::make_pair(source.name + "-" + std::to_string(i), groups[i]->metrics().snapshot()));
+    }
+
+    std::vector<ServerConnections> servers;
+    servers.reserve(servers_.size());
+    for (TcpServer *server : servers_)
+    {
+        servers.push_back(ServerConnections{server->name(), TcpServer::ConnectionStatsList()});
+        ServerConnections *entry = &servers.back();
+        // 和StatsServer在同一个loop中，回调同步执行
+        server->collectConnectionStats([entry](const TcpServer::ConnectionStatsList &list)
+                                       { entry->conns = list; });
+    }
+
+    std::string out;
+    out.reserve(4096);
+    for (const LoopFamily &family : kLoopFamilies)
+    {
+        appendHeader(&out, family.name, family.type, family.help);
+        for (const auto &item : loops)
+        {
+            out.append(family.name).append("{");
+            appendLabel(&out, "loop", item.first);
+            uint64_t value = item.second.*family.field;
+            if (family.seconds)
+                appendSeconds(&out, value * 1e-9);
+            else
+                appendValue(&out, value);
+        }
+    }
+
+    if (servers.empty())
+        return out;
+
+    appendHeader(&out, "mymuduo_server_connections", "gauge", "Open connections.");
+    for (const ServerConnections &server : servers)
+    {
+        out.append("mymuduo_server_connections{");
+        appendLabel(&out, "server", server.server);
+        appendValue(&out, static_cast<uint64_t>(server.conns.size()));
+    }
+    for (const ConnectionFamily &family : kServerFamilies)
+    {
+        appendHeader(&out, family.name, "gauge", family.help);
+        for (const ServerConnections &server : servers)
+        {
+            uint64_t value = 0;
+            for (const ConnectionStats::Snapshot &conn : server.conns)
+                value = family.peak ? std::max(value, conn.*family.field) : value + conn.*family.field;
+            out.append(family.name).append("{");
+            appendLabel(&out, "server", server.server);
+            appendValue(&out, value);
+        }
+    }
+
+    if (topConnections_ == 0)
+        return out;
+
+    // 每个服务器只保留发送缓冲区峰值最大的topConnections_条连接
+    for (ServerConnections &server : servers)
+    {
+        size_t n = std::min(topConnections_, server.conns.size());
+        std::partial_sort(server.conns.begin(), server.conns.begin() + n, server.conns.end(),
+                          [](const ConnectionStats::Snapshot &a, const ConnectionStats::Snapshot &b)
+                          { return a.peakOutputBytes > b.peakOutputBytes; });
+        server.conns.resize(n);
+    }
+    for (const ConnectionFamily &family : kConnectionFamilies)
+    {
+        appendHeader(&out, family.name, "gauge", family.help);
+        for (const ServerConnections &server : servers)
+            for (const ConnectionStats::Snapshot &conn : server.conns)
+            {
+                out.append(family.name).append("{");
+                appendLabel(&out, "server", server.server);
+                appendLabel(&out, "connection", conn.name);
+                appendValue(&out, conn.*family.field);
+            }
+    }
+    appendHeader(&out, "mymuduo_connection_first_byte_seconds", "gauge", "Time from accept to the first byte received, -1 if none yet.");
+    for (const ServerConnections &server : servers)
+        for (const ConnectionStats::Snapshot &conn : server.conns)
+        {
+            out.append("mymuduo_connection_first_byte_seconds{");
+            appendLabel(&out, "server", server.server);
+            appendLabel(&out, "connection", conn.name);
+            appendSeconds(&out, conn.firstByteNs < 0 ? -1.0 : conn.firstByteNs * 1e-9);
+        }
+    return out;
+}
@@ -0,0 +1,134 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 14:41:02
+ * @LastEditTime: 2026-10-19 14:41:02
+ */
+#include "TcpClient.h"
+
+#include "Logger.h"
+#include "Connector.h"
+#include "EventLoop.h"
+#include "TcpConnection.h"
+#include "BlockPool.h"
+#include "Socket.h"
+
+using namespace std;
+using namespace std::placeholders;
+
+// 这里定义为static怕和TcpServer的这个函数产生冲突
+// 检查EventLoop是否为空
+static EventLoop *CheckLoopNotNull(EventLoop *loop)
+{
+    if (loop == nullptr)
+        LOG_FATAL("%s:%s:%d loop is null \n", __FILE__, __FUNCTION__, __LINE__);
+    return loop;
+}
+
+// TcpClient析构之后连接才关闭时使用的关闭回调，此时不能再访问TcpClient
+static void removeConnectionAfterClient(EventLoop *loop, const TcpConnectionPtr &conn)
+{
+    loop->queueInLoop(bind(&TcpConnection::connectDestroyed, conn), conn->name().c_str());
+}
+
+// 等Connector上可能还在执行的回调都结束后再释放它
+static void removeConnector(const ConnectorPtr & /*connector*/)
+{
+}
+
+TcpClient::TcpClient(EventLoop *loop, const InetAddress &serverAddr, const string &nameArg)
+    : loop_(CheckLoopNotNull(loop)),
+      connector_(new Connector(loop, serverAddr)),
+      name_(nameArg),
+      retry_(false),
+      connect_(true),
+      nextConnId_(1)
+{
+    connector_->setNewConnectionCallback(bind(&TcpClient::newConnection, this, _1));
+    LOG_INFO("TcpClient::TcpClient[%s] - connector %p \n", name_.c_str(), connector_.get());
+}
+
+TcpClient::~TcpClient()
+{
+    LOG_INFO("TcpClient::~TcpClient[%s] - connector %p \n", name_.c_str(), connector_.get());
+    TcpConnectionPtr conn;
+    bool unique = false;
+    {
+        unique_lock<mutex> lock(mutex_);
+        unique = connection_.unique();
+        conn = connection_;
+    }
+    if (conn)
+    {
+        // 连接还在，换一个不依赖TcpClient的关闭回调
+        CloseCallback cb = bind(&removeConnectionAfterClient, loop_, _1);
+        loop_->runInLoop(bind(&TcpConnection::setCloseCallback, conn, cb));
+        if (unique)
+            conn->forceClose();
+    }
+    else
+    {
+        connector_->stop();
+        loop_->runAfter(1, bind(&removeConnector, connector_));
+    }
+}
+
+void TcpClient::connect()
+{
+    LOG_INFO("TcpClient::connect[%s] - connecting to %s \n", name_.c_str(),
+             connector_->serverAddress().toIpPort().c_str());
+    connect_ = true;
+    connector_->start();
+}
+
+void TcpClient::disconnect()
+{
+    connect_ = false;
+    unique_lock<mutex> lock(mutex_);
+    if (connection_)
+        connection_->shutdown();
+}
+
+void TcpClient::stop()
+{
+    connect_ = false;
+    connector_->stop();
+}
+
+void TcpClient::newConnection(int sockfd)
+{
+    InetAddress peerAddr(Socket::getPeerAddr(sockfd));
+    InetAddress localAddr(Socket::getLocalAddr(sockfd));
+
+    char buf[64] = {0};
+    snprintf(buf, sizeof(buf), ":%s#%d", peerAddr.toIpPort().c_str(), nextConnId_);
+    ++nextConnId_;
+    string connName = name_ + buf;
+
+    // 和TcpServer一样从loop的内存池里分配连接对象
+    TcpConnectionPtr conn = std::allocate_shared<TcpConnection>(PoolAllocator<TcpConnection>(loop_->connectionPool()),
+                                                                loop_, connName, sockfd, localAddr, peerAddr);
+    conn->setConnectionCallback(connectionCallback_);
+    conn->setMessageCallback(messageCallback_);
+    conn->setWriteCompleteCallback(writeCompleteCallback_);
+    conn->setCloseCallback(bind(&TcpClient::removeConnection, this, _1));
+    {
+        unique_lock<mutex> lock(mutex_);
+        connection_ = conn;
+    }
+    conn->connectEstablished();
+}
+
+void TcpClient::removeConnection(const TcpConnectionPtr &conn)
+{
+    {
+        unique_lock<mutex> lock(mutex_);
+        connection_.reset();
+    }
+    loop_->queueInLoop(bind(&TcpConnection::connectDestroyed, conn), conn->name().c_str());
+    if (retry_ && connect_)
+    {
+        LOG_INFO("TcpClient::connect[%s] - Reconnecting to %s \n", name_.c_str(),
+                 connector_->serverAddress().toIpPort().c_str());
+        connector_->restart();
+    }
+}
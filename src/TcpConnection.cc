@@ -5,9 +5,9 @@
  */
 #include "TcpConnection.h"
 #include "Logger.h"
-#include "Socket.h"
-#include "Channel.h"
 #include "EventLoop.h"
+#include "PhaseStats.h"
+#include "Probes.h"
 #include <string>
 
 using namespace std;
@@ -26,28 +26,35 @@ TcpConnection::TcpConnection(EventLoop *loop, const std::string &nameArg, int so
     : loop_(CheckLoopNotNull(loop)),
       name_(nameArg), state_(kConnected),
       reading_(true),
-      socket_(new Socket(sockfd)),
-      channel_(new Channel(loop, sockfd)),
+      socket_(sockfd),
+      channel_(loop, sockfd),
       localAddr_(localAddr),
       peerAddr_(peerAddr),
-      highWaterMark_(64 * 1024 * 1024) // 64M
+      highWaterMark_(64 * 1024 * 1024), // 64M
+      chainBytes_(0)
 {
     // 给channel设置相应的回调函数，poller给channel通知感兴趣的事件发生了，channel会回调相应的操作
-    channel_->setReadCallback(bind(&TcpConnection::handleRead, this, _1));
-    channel_->setWriteCallback(bind(&TcpConnection::handleWrite, this));
-    channel_->setCloseCallback(bind(&TcpConnection::handleClose, this));
-    channel_->setErrorCallback(bind(&TcpConnection::handleError, this));
+    channel_.setReadCallback(Channel::ReadEventCallback::fromMethod<TcpConnection, &TcpConnection::handleRead>(this));
+    channel_.setWriteCallback(Channel::EventCallback::fromMethod<TcpConnection, &TcpConnection::handleWrite>(this));
+    channel_.setCloseCallback(Channel::EventCallback::fromMethod<TcpConnection, &TcpConnection::handleClose>(this));
+    channel_.setErrorCallback(Channel::EventCallback::fromMethod<TcpConnection, &TcpConnection::handleError>(this));
+    channel_.setName(name_.c_str());
     LOG_INFO("TcpConnection::creator[%s] at fd=%d\n", name_.c_str(), sockfd);
-    socket_->setKeepAlive(true);
+    socket_.setKeepAlive(true);
 }
 
 TcpConnection::~TcpConnection()
 {
     LOG_INFO("TcpConnection::deletor[%s] at fd=%d state=%d \n",
-             name_.c_str(), channel_->fd(), (int)state_);
+             name_.c_str(), channel_.fd(), (int)state_);
 }
 
-void TcpConnection::send(const string &buf) // 发送数据 注意留意一下这个强制转换
+void TcpConnection::send(const string &buf) // 发送数据
+{
+    send(buf.data(), buf.size());
+}
+
+void TcpConnection::send(const void *data, size_t len)
 {
     // 连接才可以发送数据
     if (state_ == kConnected)
@@ -57,16 +64,153 @@ void TcpConnection::send(const string &buf) // 发送数据 注意留意一下
             // 其实在我们这个通信框架里面，因为TcpConnection的Channel肯定是注册到
             // 一个EventLoop里面，这个send肯定是在对应的EventLoop线程里面执行的
             // 不过有一些应用场景可能会把connection记录下来，在其他线程调用connection的send这也是有可能的
-            sendInLoop(buf.c_str(), buf.size());
+            sendInLoop(data, len);
+        }
+        else
+        {
+            // 跨线程时调用者的数据可能在回调执行前就失效了，必须拷贝一份
+            loop_->runInLoop(std::bind(&TcpConnection::sendStringInLoop,
+                                       shared_from_this(),
+                                       string(static_cast<const char *>(data), len)), name_.c_str());
+        }
+    }
+}
+
+void TcpConnection::send(Buffer *buf)
+{
+    if (state_ == kConnected)
+    {
+        if (loop_->isInLoopThread())
+        {
+            sendInLoop(buf->peek(), buf->readableBytes());
+            buf->retrieveAll();
+        }
+        else
+        {
+            loop_->runInLoop(std::bind(&TcpConnection::sendStringInLoop,
+                                       shared_from_this(),
+                                       buf->retrieveAllString()), name_.c_str());
+        }
+    }
+}
+
+void TcpConnection::sendStringInLoop(const string &message)
+{
+    sendInLoop(message.data(), message.size());
+}
+
+void TcpConnection::send(const SharedPayload &payload)
+{
+    if (state_ == kConnected)
+    {
+        if (loop_->isInLoopThread())
+            sendPayloadInLoop(payload);
+        else
+            loop_->runInLoop(std::bind(&TcpConnection::sendPayloadInLoop, shared_from_this(), payload), name_.c_str()); // 只拷贝引用
+    }
+}
+
+void TcpConnection::sendPayloadInLoop(const SharedPayload &payload)
+{
+    if (state_ == kDisconnected)
+    {
+        LOG_ERROR("disconnected, give up writing");
+        return;
+    }
+
+    size_t nwrote = 0;
+    if (!channel_.isWriting() && outputBuffer_.readableBytes() == 0)
+    {
+        // 和sendInLoop一样，没有排队的数据时先直接写，大多数情况下一次就能写完，不需要排队
+        ssize_t n = ::write(channel_.fd(), payload.data(), payload.size());
+        stats_.recordWrite(payload.size(), n);
+        if (n >= 0)
+        {
+            nwrote = n;
+            if (nwrote == payload.size())
+            {
+                if (writeCompleteCallback_)
+                    loop_->queueInLoop(bind(writeCompleteCallback_, shared_from_this()), name_.c_str());
+                return;
+            }
+        }
+        else if (errno != EWOULDBLOCK)
+        {
+            LOG_ERROR("TcpConnection::sendPayloadInLoop");
+            if (errno == EPIPE || errno == ECONNRESET)
+                return;
+        }
+    }
+
+    size_t oldLen = pendingBytes();
+    if (outputBuffer_.readableBytes() > 0)
+    {
+        // outputBuffer_中的数据要先于这份payload发送，把它们挪到发送链上保证顺序
+        outputChain_.push_back(ChainEntry{SharedPayload(outputBuffer_.retrieveAllString()), 0});
+        chainBytes_ += outputChain_.back().payload.size();
+    }
+    outputChain_.push_back(ChainEntry{payload, nwrote});
+    chainBytes_ += payload.size() - nwrote;
+
+    size_t newLen = pendingBytes();
+    stats_.recordOutputBytes(newLen);
+    if (newLen >= highWaterMark_ && oldLen < highWaterMark_ && highWaterMarkCallback_)
+        loop_->queueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), newLen), name_.c_str());
+    if (!channel_.isWriting())
+        channel_.enableWriting();
+}
+
+ssize_t TcpConnection::writeChain(int *savedErrno)
+{
+    static const int kMaxIov = 64;
+    struct iovec vec[kMaxIov];
+    int iovcnt = 0;
+    for (auto it = outputChain_.begin(); it != outputChain_.end() && iovcnt < kMaxIov - 1; ++it)
+    {
+        vec[iovcnt].iov_base = const_cast<char *>(it->payload.data()) + it->offset;
+        vec[iovcnt].iov_len = it->payload.size() - it->offset;
+        ++iovcnt;
+    }
+    if (iovcnt == static_cast<int>(outputChain_.size()) && outputBuffer_.readableBytes() > 0)
+    {
+        vec[iovcnt].iov_base = outputBuffer_.peek();
+        vec[iovcnt].iov_len = outputBuffer_.readableBytes();
+        ++iovcnt;
+    }
+
+    size_t requested = 0;
+    for (int i = 0; i < iovcnt; ++i)
+        requested += vec[i].iov_len;
+    ssize_t n = ::writev(channel_.fd(), vec, iovcnt);
+    stats_.recordWrite(requested, n);
+    if (n < 0)
+    {
+        *savedErrno = errno;
+        return n;
+    }
+
+    // 从发送链开头依次移除已经写完的数据，发送链上的引用在这里释放
+    size_t left = n;
+    while (left > 0 && !outputChain_.empty())
+    {
+        ChainEntry &entry = outputChain_.front();
+        size_t remaining = entry.payload.size() - entry.offset;
+        if (left >= remaining)
+        {
+            left -= remaining;
+            chainBytes_ -= remaining;
+            outputChain_.pop_front();
         }
         else
         {
-            loop_->runInLoop(std::bind(&TcpConnection::sendInLoop,
-                                       this,
-                                       buf.c_str(),
-                                       buf.size()));
+            entry.offset += left;
+            chainBytes_ -= left;
+            left = 0;
         }
     }
+    if (left > 0)
+        outputBuffer_.retrieve(left);
+    return n;
 }
 
 void TcpConnection::sendInLoop(const void *data, size_t len)
@@ -81,10 +225,11 @@ void TcpConnection::sendInLoop(const void *data, size_t len)
         return;
     }
 
-    if (!channel_->isWriting() && outputBuffer_.readableBytes() == 0)
+    if (!channel_.isWriting() && outputBuffer_.readableBytes() == 0)
     {
         // channel第一次开始写数据，而且用户空间的发送缓冲区中还没有待发送数据
-        nwrote = write(channel_->fd(), data, len);
+        nwrote = write(channel_.fd(), data, len);
+        stats_.recordWrite(len, nwrote);
         if (nwrote >= 0)
         {
             remaining = len - nwrote;
@@ -92,7 +237,7 @@ void TcpConnection::sendInLoop(const void *data, size_t len)
             {
                 // 既然一次性发送完了就不用再给channel设置epollout事件了，即不用设置enableWriting
                 // 这样epoll_wait就不用监听可写事件并且执行handleWrite了。这算是提高效率吧
-                loop_->queueInLoop(bind(writeCompleteCallback_, shared_from_this()));
+                loop_->queueInLoop(bind(writeCompleteCallback_, shared_from_this()), name_.c_str());
                 // 发送完数据了就调用发送完后的处理函数吧
             }
         }
@@ -109,20 +254,63 @@ void TcpConnection::sendInLoop(const void *data, size_t len)
             }
         }
     }
+    MYMUDUO_PROBE3(conn_send, channel_.fd(), len, nwrote);
     if (!faultError && remaining > 0)
     {
         // 说明刚才的write没有把数据全部拷贝到socket发送缓冲区中，剩余的数据需要保存到用户的outputBuffer缓冲区当中
         // 然后给channel注册epollout事件，poller发现tcp的发送缓冲区有空间，会通知相应的sock channel
         // 调用handleWrite回调方法，把发送缓冲区中的数据全部发送完成。
-        size_t oldLen = outputBuffer_.readableBytes(); // 目前发送缓冲区Buffer剩余的待发送数据(待拷贝到socket缓冲区)的长度
+        size_t oldLen = pendingBytes(); // 目前发送链和发送缓冲区剩余的待发送数据(待拷贝到socket缓冲区)的长度
         if (oldLen + remaining >= highWaterMark_ && oldLen < highWaterMark_ && highWaterMarkCallback_)
         {
             // 如果超过水位线
-            loop_->queueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), oldLen + remaining));
+            loop_->queueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), oldLen + remaining), name_.c_str());
         }
         outputBuffer_.append((char *)data + nwrote, remaining);
-        if (!channel_->isWriting())
-            channel_->enableWriting(); // 这里一定要注册channel的写事件，否则poller不会给channel通知pollout
+        stats_.recordOutputBytes(pendingBytes());
+        if (!channel_.isWriting())
+            channel_.enableWriting(); // 这里一定要注册channel的写事件，否则poller不会给channel通知pollout
+    }
+}
+
+void TcpConnection::flush()
+{
+    if (state_ == kDisconnected || channel_.isWriting() || outputBuffer_.readableBytes() == 0)
+    {
+        // 已经在等待可写事件的话，handleWrite会负责把剩下的数据发完
+        return;
+    }
+
+    int savedErrno = 0;
+    size_t requested = outputBuffer_.readableBytes();
+    // 协议层直接写进outputBuffer_的数据在这里第一次被看到，写之前记一次峰值
+    stats_.recordOutputBytes(requested);
+    ssize_t n = outputBuffer_.writeFd(channel_.fd(), &savedErrno);
+    stats_.recordWrite(requested, n);
+    if (n > 0)
+    {
+        outputBuffer_.retrieve(n);
+    }
+    else if (savedErrno != EWOULDBLOCK)
+    {
+        errno = savedErrno;
+        LOG_ERROR("TcpConnection::flush");
+        return; // EPIPE/ECONNRESET之类的错误，等读事件走关闭流程
+    }
+
+    if (outputBuffer_.readableBytes() == 0)
+    {
+        stats_.recordOutputBytes(0);
+        if (writeCompleteCallback_)
+            loop_->queueInLoop(bind(writeCompleteCallback_, shared_from_this()), name_.c_str());
+    }
+    else
+    {
+        size_t remaining = outputBuffer_.readableBytes();
+        stats_.recordOutputBytes(remaining);
+        if (remaining >= highWaterMark_ && highWaterMarkCallback_)
+            loop_->queueInLoop(std::bind(highWaterMarkCallback_, shared_from_this(), remaining), name_.c_str());
+        channel_.enableWriting(); // 剩余的数据等可写事件到来时由handleWrite发送
     }
 }
 
@@ -132,16 +320,34 @@ void TcpConnection::shutdown()
     {
         setState(kDisconnecting); // 这里设置成kDisconnecting是怕你缓冲区还有数据没发完
         // 在handleWrite函数中，如果发送完数据会检查state_是不是KDisconnecting，如果是就设为KDisconnected
-        loop_->runInLoop(bind(&TcpConnection::shutdownInLoop, this));
+        loop_->runInLoop(bind(&TcpConnection::shutdownInLoop, this), name_.c_str());
     }
 }
 
 void TcpConnection::shutdownInLoop()
 {
-    if (!channel_->isWriting())
+    if (!channel_.isWriting())
     {
         // 说明当前outputBuffer中的数据全部发送完成
-        socket_->shutdownWrite(); // 关闭写端 触发Channel的EPOLLHUP
+        socket_.shutdownWrite(); // 关闭写端 触发Channel的EPOLLHUP
+    }
+}
+
+void TcpConnection::forceClose()
+{
+    if (state_ == kConnected || state_ == kDisconnecting)
+    {
+        setState(kDisconnecting);
+        loop_->queueInLoop(bind(&TcpConnection::forceCloseInLoop, shared_from_this()), name_.c_str());
+    }
+}
+
+void TcpConnection::forceCloseInLoop()
+{
+    if (state_ == kConnected || state_ == kDisconnecting)
+    {
+        // 和对端关闭连接走同样的流程
+        handleClose();
     }
 }
 
@@ -149,7 +355,8 @@ void TcpConnection::shutdownInLoop()
 void TcpConnection::connectEstablished()
 {
     setState(kConnected);
-    channel_->tie(shared_from_this());
+    stats_.recordEstablished();
+    channel_.tie(shared_from_this());
     // Channel类里面有一个weak_ptr会指向这个传进来的shared_ptr<TcpConnection>
     // 如果这个TcpConnection已经被释放了，那么Channel类中的weak_ptr就没办法在
     // Channel::handleEvent 就没法提升weak_ptr。
@@ -161,20 +368,24 @@ void TcpConnection::connectEstablished()
      * 指向这个对象，这个TcpConnection对象也不会被释放。因为引用计数没有变为0.
      * 这个思想超级好，防止你里面干得好好的，外边却突然给你釜底抽薪
      */
-    channel_->enableReading(); // 向poller注册channel的epollin事件
+    channel_.enableReading(); // 向poller注册channel的epollin事件
     // 新连接建立，执行回调
-    connectionCallback_(shared_from_this());
+    if (connectionCallback_)
+        connectionCallback_(shared_from_this());
 }
 
 void TcpConnection::handleRead(TimeStamp receiveTime)
 {
     int savedErrno = 0;
-    ssize_t n = inputBuffer_.readFd(channel_->fd(), &savedErrno); // 这里的channel的fd也一定仅有socket fd
+    ssize_t n = inputBuffer_.readFd(channel_.fd(), &savedErrno); // 这里的channel的fd也一定仅有socket fd
+    stats_.recordRead(n);
+    MYMUDUO_PROBE2(conn_read, channel_.fd(), n);
     if (n > 0)                                                    // 从fd读到了数据，并且放在了inputBuffer_上
     {
         // 已建立连接的用户，有可读事件发生了，调用用户传入的回调操作onMessage
         // 这个shared_from_this()就是TcpConnection对象的智能指针
         messageCallback_(shared_from_this(), &inputBuffer_, receiveTime);
+        MYMUDUO_PROBE2(conn_message_done, channel_.fd(), inputBuffer_.readableBytes());
     }
     else if (n == 0)
         handleClose();
@@ -188,21 +399,36 @@ void TcpConnection::handleRead(TimeStamp receiveTime)
 
 void TcpConnection::handleWrite()
 {
-    if (channel_->isWriting()) // 当前感兴趣的事件是否包含可写事件
+    if (channel_.isWriting()) // 当前感兴趣的事件是否包含可写事件
     {
         int savedErrno = 0;
-        ssize_t n = outputBuffer_.writeFd(channel_->fd(), &savedErrno); // 通过fd发送数据
-        if (n > 0)                                                      // n > 0说明向Buffer写入成功，Buffer是要发出去给socket的数据
+        ssize_t n = 0;
+        // 等待可写期间协议层可能又往outputBuffer_里追加了数据，写之前记一次峰值
+        stats_.recordOutputBytes(pendingBytes());
+        if (outputChain_.empty())
         {
-            outputBuffer_.retrieve(n);
-            if (outputBuffer_.readableBytes() == 0)
+            size_t requested = outputBuffer_.readableBytes();
+            n = outputBuffer_.writeFd(channel_.fd(), &savedErrno); // 通过fd发送数据
+            stats_.recordWrite(requested, n);
+            if (n > 0)
+                outputBuffer_.retrieve(n);
+        }
+        else
+        {
+            n = writeChain(&savedErrno); // 发送链和outputBuffer_一起writev出去
+        }
+        MYMUDUO_PROBE3(conn_write, channel_.fd(), n, pendingBytes());
+        if (n > 0) // n > 0说明向socket写入成功
+        {
+            stats_.recordOutputBytes(pendingBytes());
+            if (pendingBytes() == 0)
             {
                 // Buffer里面已经没有数据了
-                channel_->disableWriting(); // 关闭这个channel的可写事件，
+                channel_.disableWriting(); // 关闭这个channel的可写事件，
                 if (writeCompleteCallback_)
                 {
                     loop_->queueInLoop(
-                        std::bind(writeCompleteCallback_, shared_from_this())); // queueInLoop，唤醒这个loop对应的thread线程来执行回调，其实我觉得这里也可以是runInLoop，的确也可以是
+                        std::bind(writeCompleteCallback_, shared_from_this()), name_.c_str()); // queueInLoop，唤醒这个loop对应的thread线程来执行回调，其实我觉得这里也可以是runInLoop，的确也可以是
                 }
                 if (state_ == kDisconnecting) // 正在关闭中
                 {
@@ -217,15 +443,15 @@ void TcpConnection::handleWrite()
     }
     else
     {
-        LOG_ERROR("TcpConnection fd=%d is down, no more writing \n", channel_->fd());
+        LOG_ERROR("TcpConnection fd=%d is down, no more writing \n", channel_.fd());
     }
 }
 
 void TcpConnection::handleClose()
 {
-    LOG_INFO("fd=%d state=%d \n", channel_->fd(), static_cast<int>(state_));
+    LOG_INFO("fd=%d state=%d \n", channel_.fd(), static_cast<int>(state_));
     setState(kDisconnected);
-    channel_->disableAll();
+    channel_.disableAll();
     TcpConnectionPtr connPtr(shared_from_this());
 
     /** @todo：为什么要执行连接调用？*/
@@ -242,7 +468,7 @@ void TcpConnection::handleError()
     int err = 0;
 
     // 《Linux高性能服务器编程》page88，获取并清除socket错误状态,getsockopt成功则返回0,失败则返回-1
-    if (getsockopt(channel_->fd(), SOL_SOCKET, SO_ERROR, &optval, &optlen) < 0)
+    if (getsockopt(channel_.fd(), SOL_SOCKET, SO_ERROR, &optval, &optlen) < 0)
         err = errno;
     else
         err = optval;
@@ -252,11 +478,13 @@ void TcpConnection::handleError()
 // 连接销毁
 void TcpConnection::connectDestroyed()
 {
+    PhaseStats::Scope phase(PhaseStats::kConnectDestroyed);
     if (state_ == kConnected)
     {
         setState(kDisconnected);
-        channel_->disableAll();
-        connectionCallback_(shared_from_this());
+        channel_.disableAll();
+        if (connectionCallback_)
+            connectionCallback_(shared_from_this());
     }
-    channel_->remove(); // 把channel从poller中删除掉。
+    channel_.remove(); // 把channel从poller中删除掉。
 }
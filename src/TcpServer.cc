@@ -7,6 +7,9 @@
 #include "Logger.h"
 #include <strings.h>
 #include "TcpConnection.h"
+#include "BlockPool.h"
+#include "PhaseStats.h"
+#include "Probes.h"
 
 using namespace std;
 using namespace std::placeholders;
@@ -50,7 +53,7 @@ TcpServer::~TcpServer()
          ***/
         TcpConnectionPtr conn(item.second);
         item.second.reset();
-        conn->getLoop()->runInLoop(bind(&TcpConnection::connectDestroyed, conn));
+        conn->getLoop()->runInLoop(bind(&TcpConnection::connectDestroyed, conn), conn->name().c_str());
     }
 }
 
@@ -74,6 +77,7 @@ void TcpServer::start() // 开启服务器监听
 
 void TcpServer::newConnection(int sockfd, const InetAddress &peerAddr)
 {
+    PhaseStats::Scope phase(PhaseStats::kNewConnection);
     EventLoop *ioLoop = threadPool_->getNextLoop(); // 轮循算法选择一个subLoop来管理新连接的channel
     char buf[64] = {0};
     snprintf(buf, sizeof(buf), "-%s#%d", ipPort_.c_str(), nextConnId_); // 表示一个连接的名称
@@ -81,20 +85,14 @@ void TcpServer::newConnection(int sockfd, const InetAddress &peerAddr)
     string connName = name_ + buf;
     LOG_INFO("TcpServer::newConnection [%s] - new connection [%s] from %s \n",
              name_.c_str(), connName.c_str(), peerAddr.toIpPort().c_str());
-    // 通过sockfd获取其绑定的本机的ip地址和端口信息
-    sockaddr_in local;
-    bzero(&local, sizeof(local));
-    socklen_t addrlen = sizeof(local);
-    if (getsockname(sockfd, (sockaddr *)&local, &addrlen) < 0)
-    {
-        // getsockname函数用于获取与某个套接字关联的本地协议地址，然后放到local里面
-        LOG_ERROR("sockets::getLocalAddr");
-    }
-
-    InetAddress localAddr(local);
+    // 通过sockfd获取其绑定的本机的地址信息
+    InetAddress localAddr(Socket::getLocalAddr(sockfd));
     // 根据连接成功的sockfd创建TcpConnection连接对象
-    TcpConnectionPtr conn(new TcpConnection(ioLoop, connName, sockfd, localAddr, peerAddr));
+    // 从subLoop的内存池里分配，TcpConnection（内嵌Socket和Channel）和shared_ptr控制块只占一次分配，连接关闭后内存块被回收复用
+    TcpConnectionPtr conn = std::allocate_shared<TcpConnection>(PoolAllocator<TcpConnection>(ioLoop->connectionPool()),
+                                                                ioLoop, connName, sockfd, localAddr, peerAddr);
     connections_[connName] = conn;
+    MYMUDUO_PROBE2(new_connection, sockfd, connName.c_str());
 
     // 下面的回调都是用户设置给TcpServer的
     conn->setConnectionCallback(connectionCallback_);
@@ -102,7 +100,7 @@ void TcpServer::newConnection(int sockfd, const InetAddress &peerAddr)
     conn->setWriteCompleteCallback(writeCompleteCallback_);
     conn->setCloseCallback(bind(&TcpServer::removeConnection, this, _1));
 
-    ioLoop->runInLoop(bind(&TcpConnection::connectEstablished, conn));
+    ioLoop->runInLoop(bind(&TcpConnection::connectEstablished, conn), conn->name().c_str());
 }
 
 void TcpServer::removeConnection(const TcpConnectionPtr &conn)
@@ -114,10 +112,67 @@ void TcpServer::removeConnection(const TcpConnectionPtr &conn)
 
 void TcpServer::removeConnectionInLoop(const TcpConnectionPtr &conn)
 {
+    PhaseStats::Scope phase(PhaseStats::kRemoveConnection);
     LOG_INFO("TcpServer::removeConnectionInLoop [%s] - connection %s\n",
              name_.c_str(), conn->name().c_str());
     connections_.erase(conn->name());
     EventLoop *ioLoop = conn->getLoop();
-    ioLoop->queueInLoop(bind(&TcpConnection::connectDestroyed, conn));
+    ioLoop->queueInLoop(bind(&TcpConnection::connectDestroyed, conn), conn->name().c_str());
     // 拐来拐去最后又拐到connectDestroyed
 }
+
+// 在连接所属的loop中，把payload的引用挂到这一组连接的发送链上
+static void sendPayloadToGroup(const std::shared_ptr<std::vector<TcpConnectionPtr>> &conns, const SharedPayload &payload)
+{
+    for (const TcpConnectionPtr &conn : *conns)
+        conn->send(payload);
+}
+
+void TcpServer::broadcast(const std::vector<TcpConnectionPtr> &conns, const SharedPayload &payload)
+{
+    using ConnectionList = std::vector<TcpConnectionPtr>;
+    std::unordered_map<EventLoop *, std::shared_ptr<ConnectionList>> groups;
+    for (const TcpConnectionPtr &conn : conns)
+    {
+        std::shared_ptr<ConnectionList> &group = groups[conn->getLoop()];
+        if (!group)
+            group = std::make_shared<ConnectionList>();
+        group->push_back(conn);
+    }
+    // 每个loop一个任务，而不是每个连接一个跨线程的闭包
+    for (auto &item : groups)
+        item.first->runInLoop(std::bind(sendPayloadToGroup, item.second, payload));
+}
+
+void TcpServer::broadcast(const SharedPayload &payload)
+{
+    // connections_只能在baseLoop中访问
+    loop_->runInLoop(std::bind(&TcpServer::broadcastInLoop, this, payload));
+}
+
+void TcpServer::broadcastInLoop(const SharedPayload &payload)
+{
+    std::vector<TcpConnectionPtr> conns;
+    conns.reserve(connections_.size());
+    for (auto &item : connections_)
+        conns.push_back(item.second);
+    broadcast(conns, payload);
+}
+
+void TcpServer::collectConnectionStats(const ConnectionStatsCallback &cb)
+{
+    // connections_只能在baseLoop中访问
+    loop_->runInLoop(std::bind(&TcpServer::collectConnectionStatsInLoop, this, cb));
+}
+
+void TcpServer::collectConnectionStatsInLoop(const ConnectionStatsCallback &cb)
+{
+    ConnectionStatsList list;
+    list.reserve(connections_.size());
+    for (auto &item : connections_)
+    {
+        list.push_back(item.second->stats().snapshot());
+        list.back().name = item.first;
+    }
+    cb(list);
+}
@@ -0,0 +1,229 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-20 11:11:30
+ * @LastEditTime: 2026-10-20 11:11:30
+ */
+#include "ThreadPool.h"
+#include "Thread.h"
+#include "Logger.h"
+
+namespace
+{
+    // 当前线程所属的线程池和它在线程池中的下标，工作线程中提交的任务直接放进自己的队列
+    thread_local ThreadPool *t_pool = nullptr;
+    thread_local size_t t_workerIndex = 0;
+}
+
+ThreadPool::ThreadPool(const std::string &name)
+    : name_(name),
+      maxQueueSize_(kDefaultMaxQueueSize),
+      rejectPolicy_(kReject),
+      running_(false),
+      nextWorker_(0),
+      queued_(0),
+      peakQueued_(0),
+      submitted_(0),
+      completed_(0),
+      rejected_(0),
+      callerRuns_(0),
+      stolen_(0),
+      idleWorkers_(0),
+      blockedSubmitters_(0)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+void ThreadPool::start(int numThreads)
+{
+    if (numThreads <= 0)
+        numThreads = 1;
+    running_ = true;
+    workers_.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i)
+        workers_.emplace_back(new Worker);
+    for (int i = 0; i < numThreads; ++i)
+    {
+        workers_[i]->thread.reset(new Thread(std::bind(&ThreadPool::workerThread, this, i),
+                                             name_ + std::to_string(i)));
+        workers_[i]->thread->start();
+    }
+}
+
+void ThreadPool::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (!running_)
+            return; // 没有启动或者已经停止
+        running_ = false;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+    for (std::unique_ptr<Worker> &worker : workers_)
+        worker->thread->join();
+    // 队列都已经取空，清掉之后可以重新start
+    workers_.clear();
+}
+
+bool ThreadPool::submit(Task task)
+{
+    if (!running_)
+    {
+        ++rejected_;
+        return false;
+    }
+    if (!reserveSlot(&task))
+        return task ? false : true; // 被拒绝时task还在；kCallerRuns时task已经执行并清空
+
+    // 占到名额之后再检查一次：stop如果发生在上面的检查之后，工作线程可能已经看到queued_为0退出了，
+    // 任务放进队列就再也没人执行。先加queued_再读running_，工作线程在running_为false后读queued_，
+    // 两边至少有一边能看到对方的修改：要么这里看到已停止而撤销，要么工作线程看到这个名额而留下来执行
+    if (!running_)
+    {
+        queued_.fetch_sub(1);
+        ++rejected_;
+        return false;
+    }
+    push(std::move(task));
+    return true;
+}
+
+bool ThreadPool::reserveSlot(Task *task)
+{
+    size_t queued = queued_.fetch_add(1) + 1;
+    while (queued > maxQueueSize_)
+    {
+        queued_.fetch_sub(1);
+        if (rejectPolicy_ == kCallerRuns)
+        {
+            ++callerRuns_;
+            (*task)();
+            *task = Task();
+            return false;
+        }
+        if (rejectPolicy_ == kReject)
+        {
+            ++rejected_;
+            return false;
+        }
+
+        // kBlock：等待工作线程取走任务
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            ++blockedSubmitters_;
+            notFull_.wait(lock, [this]()
+                          { return queued_.load() < maxQueueSize_ || !running_; });
+            --blockedSubmitters_;
+        }
+        if (!running_)
+        {
+            ++rejected_;
+            return false;
+        }
+        queued = queued_.fetch_add(1) + 1;
+    }
+
+    size_t peak = peakQueued_.load(std::memory_order_relaxed);
+    while (queued > peak && !peakQueued_.compare_exchange_weak(peak, queued, std::memory_order_relaxed))
+    {
+    }
+    return true;
+}
+
+void ThreadPool::push(Task task)
+{
+    size_t index = t_pool == this ? t_workerIndex : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    Worker &worker = *workers_[index];
+    {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    ++submitted_;
+
+    // queued_已经先加过了，工作线程在sleepMutex_下检查queued_后才睡眠，这里只在有空闲线程时才需要唤醒
+    if (idleWorkers_.load() > 0)
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        notEmpty_.notify_one();
+    }
+}
+
+bool ThreadPool::takeTask(size_t index, Task *task)
+{
+    {
+        Worker &self = *workers_[index];
+        std::unique_lock<std::mutex> lock(self.mutex);
+        if (!self.tasks.empty())
+        {
+            *task = std::move(self.tasks.front());
+            self.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // 自己的队列空了，从下一个开始依次窃取，减少多个线程同时窃取同一个队列
+    for (size_t i = 1; i < workers_.size(); ++i)
+    {
+        Worker &victim = *workers_[(index + i) % workers_.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            *task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            ++stolen_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerThread(size_t index)
+{
+    t_pool = this;
+    t_workerIndex = index;
+
+    Task task;
+    for (;;)
+    {
+        if (takeTask(index, &task))
+        {
+            queued_.fetch_sub(1);
+            if (blockedSubmitters_.load() > 0)
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex_);
+                notFull_.notify_one();
+            }
+
+            task();
+            task = Task(); // 任务携带的数据在这里释放，不留到下一个任务
+            ++completed_;
+            continue;
+        }
+
+        // 没有取到任务：queued_不为0说明有任务正在放入队列，稍后再取
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (queued_.load() == 0 && !running_)
+            break;
+        ++idleWorkers_;
+        notEmpty_.wait(lock, [this]()
+                       { return queued_.load() > 0 || !running_; });
+        --idleWorkers_;
+    }
+}
+
+ThreadPool::Stats ThreadPool::stats() const
+{
+    Stats stats;
+    stats.queued = queued_.load(std::memory_order_relaxed);
+    stats.peakQueued = peakQueued_.load(std::memory_order_relaxed);
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.completed = completed_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.callerRuns = callerRuns_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,16 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 13:11:02
+ * @LastEditTime: 2026-10-19 13:11:02
+ */
+#include "Timer.h"
+
+std::atomic<int64_t> Timer::numCreated_(0);
+
+void Timer::restart(TimeStamp now)
+{
+    if (repeat_)
+        expiration_ = addTime(now, interval_);
+    else
+        expiration_ = TimeStamp();
+}
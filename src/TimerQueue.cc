@@ -0,0 +1,184 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 13:20:17
+ * @LastEditTime: 2026-10-19 13:20:17
+ */
+#include "TimerQueue.h"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+
+#include "Logger.h"
+#include "EventLoop.h"
+#include "Timer.h"
+
+// 创建timerfd
+static int createTimerfd()
+{
+    int timerfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerfd < 0)
+        LOG_FATAL("%s:%s:%d timerfd_create err:%d \n", __FILE__, __FUNCTION__, __LINE__, errno);
+    return timerfd;
+}
+
+// 计算从现在到when的时间间隔
+static struct timespec howMuchTimeFromNow(TimeStamp when)
+{
+    int64_t microseconds = when.microSecondsSinceEpoch() - TimeStamp::now().microSecondsSinceEpoch();
+    if (microseconds < 100)
+        microseconds = 100; // timerfd的时间不能为0，为0表示停止定时器
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(microseconds / TimeStamp::kMicroSecondsPerSecond);
+    ts.tv_nsec = static_cast<long>((microseconds % TimeStamp::kMicroSecondsPerSecond) * 1000);
+    return ts;
+}
+
+// 读走timerfd上的超时次数，否则LT模式下会一直触发
+static void readTimerfd(int timerfd)
+{
+    uint64_t howmany;
+    ssize_t n = ::read(timerfd, &howmany, sizeof(howmany));
+    if (n != sizeof(howmany))
+        LOG_ERROR("TimerQueue::handleRead() reads %ld bytes instead of 8 \n", n);
+}
+
+// 把timerfd设置为在expiration时刻到期
+static void resetTimerfd(int timerfd, TimeStamp expiration)
+{
+    struct itimerspec newValue;
+    struct itimerspec oldValue;
+    memset(&newValue, 0, sizeof(newValue));
+    memset(&oldValue, 0, sizeof(oldValue));
+    newValue.it_value = howMuchTimeFromNow(expiration);
+    if (::timerfd_settime(timerfd, 0, &newValue, &oldValue) < 0)
+        LOG_ERROR("timerfd_settime error:%d \n", errno);
+}
+
+TimerQueue::TimerQueue(EventLoop *loop)
+    : loop_(loop),
+      timerfd_(createTimerfd()),
+      timerfdChannel_(loop, timerfd_),
+      callingExpiredTimers_(false)
+{
+    timerfdChannel_.setReadCallback(Channel::ReadEventCallback::fromMethod<TimerQueue, &TimerQueue::handleRead>(this));
+    timerfdChannel_.setName("TimerQueue");
+    timerfdChannel_.enableReading();
+}
+
+TimerQueue::~TimerQueue()
+{
+    timerfdChannel_.disableAll();
+    timerfdChannel_.remove();
+    ::close(timerfd_);
+    for (const Entry &timer : timers_)
+        delete timer.second;
+}
+
+TimerId TimerQueue::addTimer(TimerCallback cb, TimeStamp when, double interval)
+{
+    Timer *timer = new Timer(std::move(cb), when, interval);
+    // 定时器集合只在loop线程中修改
+    loop_->runInLoop(std::bind(&TimerQueue::addTimerInLoop, this, timer));
+    return TimerId(timer, timer->sequence());
+}
+
+void TimerQueue::cancel(TimerId timerId)
+{
+    loop_->runInLoop(std::bind(&TimerQueue::cancelInLoop, this, timerId));
+}
+
+void TimerQueue::addTimerInLoop(Timer *timer)
+{
+    bool earliestChanged = insert(timer);
+    // 新的定时器比之前的都早到期，需要重新设置timerfd
+    if (earliestChanged)
+        resetTimerfd(timerfd_, timer->expiration());
+}
+
+void TimerQueue::cancelInLoop(TimerId timerId)
+{
+    ActiveTimer timer(timerId.timer_, timerId.sequence_);
+    ActiveTimerSet::iterator it = activeTimers_.find(timer);
+    if (it != activeTimers_.end())
+    {
+        timers_.erase(Entry(it->first->expiration(), it->first));
+        delete it->first;
+        activeTimers_.erase(it);
+    }
+    else if (callingExpiredTimers_)
+    {
+        // 定时器正在执行回调(比如在自己的回调里取消自己)，记录下来，防止reset时被重新插入
+        cancelingTimers_.insert(timer);
+    }
+}
+
+void TimerQueue::handleRead(TimeStamp /*receiveTime*/)
+{
+    TimeStamp now(TimeStamp::now());
+    readTimerfd(timerfd_);
+
+    std::vector<Entry> expired = getExpired(now);
+
+    callingExpiredTimers_ = true;
+    cancelingTimers_.clear();
+    for (const Entry &it : expired)
+        it.second->run();
+    callingExpiredTimers_ = false;
+
+    reset(expired, now);
+}
+
+std::vector<TimerQueue::Entry> TimerQueue::getExpired(TimeStamp now)
+{
+    std::vector<Entry> expired;
+    // 哨兵值，比所有到期时间为now的定时器都大
+    Entry sentry(now, reinterpret_cast<Timer *>(UINTPTR_MAX));
+    TimerList::iterator end = timers_.lower_bound(sentry);
+    std::copy(timers_.begin(), end, std::back_inserter(expired));
+    timers_.erase(timers_.begin(), end);
+
+    for (const Entry &it : expired)
+        activeTimers_.erase(ActiveTimer(it.second, it.second->sequence()));
+    return expired;
+}
+
+void TimerQueue::reset(const std::vector<Entry> &expired, TimeStamp now)
+{
+    for (const Entry &it : expired)
+    {
+        ActiveTimer timer(it.second, it.second->sequence());
+        if (it.second->repeat() && cancelingTimers_.find(timer) == cancelingTimers_.end())
+        {
+            it.second->restart(now);
+            insert(it.second);
+        }
+        else
+        {
+            delete it.second;
+        }
+    }
+
+    if (!timers_.empty())
+    {
+        TimeStamp nextExpire = timers_.begin()->second->expiration();
+        if (nextExpire.valid())
+            resetTimerfd(timerfd_, nextExpire);
+    }
+}
+
+bool TimerQueue::insert(Timer *timer)
+{
+    bool earliestChanged = false;
+    TimeStamp when = timer->expiration();
+    TimerList::iterator it = timers_.begin();
+    if (it == timers_.end() || when < it->first)
+        earliestChanged = true;
+    timers_.insert(Entry(when, timer));
+    activeTimers_.insert(ActiveTimer(timer, timer->sequence()));
+    return earliestChanged;
+}
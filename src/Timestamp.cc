@@ -6,18 +6,23 @@
 
 #include "TimeStamp.h"
 
-TimeStamp::TimeStamp(int64_t secondSinceEpoch)
-    : secondSinceEpoch_(secondSinceEpoch) {}
+#include <sys/time.h>
+
+TimeStamp::TimeStamp(int64_t microSecondsSinceEpoch)
+    : microSecondsSinceEpoch_(microSecondsSinceEpoch) {}
 
 TimeStamp TimeStamp::now()
 {
-    return TimeStamp(time(NULL));
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return TimeStamp(static_cast<int64_t>(tv.tv_sec) * kMicroSecondsPerSecond + tv.tv_usec);
 }
 
 std::string TimeStamp::toString() const
 {
     char buf[128] = {0};
-    tm *tm_time = localtime(&secondSinceEpoch_);
+    time_t seconds = secondsSinceEpoch();
+    tm *tm_time = localtime(&seconds);
     snprintf(buf, 128, "%4d/%02d/%02d %02d:%02d:%02d",
              tm_time->tm_year + 1900,
              tm_time->tm_mon + 1,
@@ -26,4 +31,4 @@ std::string TimeStamp::toString() const
              tm_time->tm_min,
              tm_time->tm_sec);
     return buf;
-}
\ No newline at end of file
+}
@@ -0,0 +1,344 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 16:21:37
+ * @LastEditTime: 2026-10-19 16:21:37
+ */
+#include "UdpChannel.h"
+
+#include <errno.h>
+#include <string.h>
+#include <netinet/udp.h>
+#include <functional>
+#include <algorithm>
+
+#include "Logger.h"
+#include "EventLoop.h"
+
+using namespace std;
+
+const size_t UdpChannel::kDefaultBatchSize;
+const size_t UdpChannel::kDefaultMaxDatagramSize;
+
+static const int kMaxReadRounds = 16;         // 一次可读事件最多读多少批，避免一个socket饿死同一个loop上的其他fd
+static const size_t kGroSlotSize = 65536;     // 开启GRO后每个接收槽要能放下一个合并包
+static const size_t kMaxGroBatchSize = 16;    // 开启GRO后接收槽很大，限制槽的个数控制内存
+static const size_t kGroControlSize = CMSG_SPACE(sizeof(int));
+
+UdpChannel::UdpChannel(EventLoop *loop, const InetAddress &bindAddr, const string &name, bool reusePort,
+                       size_t batchSize, size_t maxDatagramSize)
+    : loop_(loop),
+      name_(name),
+      localAddr_(bindAddr),
+      socket_(bindAddr.family()),
+      channel_(loop, socket_.fd()),
+      batchSize_(batchSize),
+      maxDatagramSize_(maxDatagramSize),
+      recvBatchSize_(batchSize),
+      recvSlotSize_(maxDatagramSize),
+      groEnabled_(false),
+      gsoSupported_(true),
+      sendBuffer_(batchSize * maxDatagramSize),
+      sendMsgs_(batchSize),
+      sendIovecs_(batchSize),
+      sendAddrs_(batchSize),
+      pendingSends_(0),
+      flushScheduled_(false),
+      inReadCallback_(false),
+      received_(0),
+      sent_(0),
+      dropped_(0),
+      truncated_(0),
+      groPackets_(0),
+      gsoSends_(0)
+{
+    socket_.setReuseAddr(true);
+    socket_.setReusePort(reusePort);
+    socket_.bindAddress(bindAddr);
+
+    // 接收和发送批次的mmsghdr在构造时就和各自的缓冲区关联好，之后每次只需要更新长度
+    setupRecvBatch();
+    for (size_t i = 0; i < batchSize_; ++i)
+    {
+        sendIovecs_[i].iov_base = &sendBuffer_[i * maxDatagramSize_];
+        memset(&sendMsgs_[i], 0, sizeof(sendMsgs_[i]));
+        sendMsgs_[i].msg_hdr.msg_iov = &sendIovecs_[i];
+        sendMsgs_[i].msg_hdr.msg_iovlen = 1;
+        sendMsgs_[i].msg_hdr.msg_name = &sendAddrs_[i];
+    }
+    channel_.setReadCallback(Channel::ReadEventCallback::fromMethod<UdpChannel, &UdpChannel::handleRead>(this));
+}
+
+void UdpChannel::setupRecvBatch()
+{
+    recvBuffer_.assign(recvBatchSize_ * recvSlotSize_, 0);
+    recvControl_.assign(groEnabled_ ? recvBatchSize_ * kGroControlSize : 0, 0);
+    recvMsgs_.resize(recvBatchSize_);
+    recvIovecs_.resize(recvBatchSize_);
+    recvAddrs_.resize(recvBatchSize_);
+    // 开启GRO后一个合并包最多包含UdpSocket::kMaxGsoSegments个数据报，提前预留好，handleRead中不再分配内存
+    datagrams_.reserve(groEnabled_ ? recvBatchSize_ * UdpSocket::kMaxGsoSegments : recvBatchSize_);
+    for (size_t i = 0; i < recvBatchSize_; ++i)
+    {
+        recvIovecs_[i].iov_base = &recvBuffer_[i * recvSlotSize_];
+        recvIovecs_[i].iov_len = recvSlotSize_;
+        memset(&recvMsgs_[i], 0, sizeof(recvMsgs_[i]));
+        recvMsgs_[i].msg_hdr.msg_iov = &recvIovecs_[i];
+        recvMsgs_[i].msg_hdr.msg_iovlen = 1;
+        recvMsgs_[i].msg_hdr.msg_name = &recvAddrs_[i];
+        if (groEnabled_)
+            recvMsgs_[i].msg_hdr.msg_control = &recvControl_[i * kGroControlSize];
+    }
+}
+
+bool UdpChannel::enableGro()
+{
+    if (!socket_.setGro(true))
+        return false;
+    groEnabled_ = true;
+    recvSlotSize_ = kGroSlotSize;
+    recvBatchSize_ = std::min(batchSize_, kMaxGroBatchSize);
+    setupRecvBatch();
+    return true;
+}
+
+UdpChannel::~UdpChannel()
+{
+    // 析构前必须已经在loop线程中stop，channel已从poller中移除
+    LOG_INFO("UdpChannel::dtor[%s] at fd=%d \n", name_.c_str(), socket_.fd());
+}
+
+void UdpChannel::start()
+{
+    loop_->runInLoop(bind(&UdpChannel::startInLoop, shared_from_this()));
+}
+
+void UdpChannel::startInLoop()
+{
+    channel_.enableReading();
+}
+
+void UdpChannel::stop()
+{
+    loop_->runInLoop(bind(&UdpChannel::stopInLoop, shared_from_this()));
+}
+
+void UdpChannel::stopInLoop()
+{
+    flush();
+    channel_.disableAll();
+    channel_.remove();
+}
+
+void UdpChannel::send(const InetAddress &peer, const char *data, size_t len)
+{
+    if (loop_->isInLoopThread())
+    {
+        appendToSendBatch(peer, data, len);
+        // handleRead中发送的数据报由handleRead在回调结束后统一flush
+        if (!inReadCallback_ && !flushScheduled_)
+        {
+            flushScheduled_ = true;
+            loop_->queueInLoop(bind(&UdpChannel::flush, shared_from_this()));
+        }
+    }
+    else
+    {
+        // 跨线程时必须拷贝数据，调用方的缓冲区在回调执行时可能已经失效
+        loop_->runInLoop(bind(&UdpChannel::sendInLoop, shared_from_this(), peer, string(data, len)));
+    }
+}
+
+void UdpChannel::sendInLoop(const InetAddress &peer, const string &data)
+{
+    send(peer, data.data(), data.size());
+}
+
+void UdpChannel::sendSegmented(const InetAddress &peer, const char *data, size_t len, size_t segmentSize)
+{
+    if (loop_->isInLoopThread())
+        sendSegmentedInLoop(peer, string(data, len), segmentSize);
+    else
+        loop_->runInLoop(bind(&UdpChannel::sendSegmentedInLoop, shared_from_this(), peer, string(data, len), segmentSize));
+}
+
+void UdpChannel::sendSegmentedInLoop(const InetAddress &peer, const string &data, size_t segmentSize)
+{
+    if (segmentSize == 0)
+        return;
+    // 保证和之前send的数据报的顺序
+    flush();
+
+    // 每次GSO最多kMaxGsoSegments个分段，总长度也不能超过一个IP包
+    size_t segmentsPerSend = std::min(UdpSocket::kMaxGsoSegments, UdpSocket::kMaxGsoBytes / segmentSize);
+    size_t offset = 0;
+    bool useGso = gsoSupported_;
+    while (useGso && segmentsPerSend > 1 && offset < data.size())
+    {
+        size_t chunk = std::min(data.size() - offset, segmentsPerSend * segmentSize);
+        size_t segments = (chunk + segmentSize - 1) / segmentSize;
+        int savedErrno = 0;
+        ssize_t n = socket_.sendSegmented(data.data() + offset, chunk, static_cast<uint16_t>(segmentSize), peer, &savedErrno);
+        if (n >= 0)
+        {
+            ++gsoSends_;
+            sent_ += segments;
+            offset += chunk;
+        }
+        else if (savedErrno == EAGAIN || savedErrno == EWOULDBLOCK)
+        {
+            dropped_ += (data.size() - offset + segmentSize - 1) / segmentSize;
+            return;
+        }
+        else if (savedErrno == ENOPROTOOPT || savedErrno == EIO || savedErrno == EOPNOTSUPP)
+        {
+            // 内核或网卡不支持UDP_SEGMENT，以后都走普通批量发送
+            LOG_INFO("UdpChannel [%s] - UDP GSO unsupported (errno %d), falling back to sendmmsg \n", name_.c_str(), savedErrno);
+            gsoSupported_ = false;
+            useGso = false;
+        }
+        else if (savedErrno == EINVAL)
+        {
+            // 只是这一次的参数不合法（比如分段超过路径MTU、分段数太多），这次剩下的数据走普通批量发送，GSO仍然保留
+            LOG_DEBUG("UdpChannel [%s] - UDP GSO rejected this send (EINVAL), using sendmmsg \n", name_.c_str());
+            useGso = false;
+        }
+        else
+        {
+            LOG_DEBUG("UdpChannel::sendSegmented [%s] error:%d \n", name_.c_str(), savedErrno);
+            dropped_ += segments;
+            offset += chunk;
+        }
+    }
+
+    // 不支持GSO时按段放入普通的发送批次
+    for (; offset < data.size(); offset += segmentSize)
+        appendToSendBatch(peer, data.data() + offset, std::min(segmentSize, data.size() - offset));
+    flush();
+}
+
+void UdpChannel::appendToSendBatch(const InetAddress &peer, const char *data, size_t len)
+{
+    if (len > maxDatagramSize_)
+    {
+        // 放不进发送批次的大数据报单独发送，先把前面的发出去保证顺序
+        flush();
+        int savedErrno = 0;
+        if (socket_.sendTo(data, len, peer, &savedErrno) < 0)
+        {
+            ++dropped_;
+            LOG_DEBUG("UdpChannel::sendTo [%s] error:%d \n", name_.c_str(), savedErrno);
+        }
+        else
+        {
+            ++sent_;
+        }
+        return;
+    }
+    if (pendingSends_ == batchSize_)
+        flush();
+
+    size_t i = pendingSends_++;
+    memcpy(sendIovecs_[i].iov_base, data, len);
+    sendIovecs_[i].iov_len = len;
+    memcpy(&sendAddrs_[i], peer.getSockAddr(), peer.getSockLen());
+    sendMsgs_[i].msg_hdr.msg_namelen = peer.getSockLen();
+}
+
+void UdpChannel::flush()
+{
+    flushScheduled_ = false;
+    size_t offset = 0;
+    while (offset < pendingSends_)
+    {
+        int savedErrno = 0;
+        int n = socket_.sendBatch(&sendMsgs_[offset], static_cast<unsigned int>(pendingSends_ - offset), &savedErrno);
+        if (n > 0)
+        {
+            offset += n;
+            sent_ += n;
+        }
+        else if (savedErrno == EAGAIN || savedErrno == EWOULDBLOCK)
+        {
+            // 内核发送缓冲区满了，UDP不做重传，剩下的直接丢弃
+            dropped_ += pendingSends_ - offset;
+            break;
+        }
+        else
+        {
+            // 第一个数据报发送失败(比如目标不可达)，跳过它继续发送后面的
+            LOG_DEBUG("UdpChannel::flush [%s] sendmmsg error:%d \n", name_.c_str(), savedErrno);
+            ++dropped_;
+            ++offset;
+        }
+    }
+    pendingSends_ = 0;
+}
+
+void UdpChannel::handleRead(TimeStamp receiveTime)
+{
+    UdpChannelPtr guard(shared_from_this());
+    inReadCallback_ = true;
+    for (int round = 0; round < kMaxReadRounds; ++round)
+    {
+        // 内核会修改msg_namelen、msg_controllen和msg_flags，每次读之前要复位
+        for (size_t i = 0; i < recvBatchSize_; ++i)
+        {
+            recvMsgs_[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            recvMsgs_[i].msg_hdr.msg_controllen = groEnabled_ ? kGroControlSize : 0;
+            recvMsgs_[i].msg_hdr.msg_flags = 0;
+        }
+
+        int savedErrno = 0;
+        int n = socket_.recvBatch(&recvMsgs_[0], static_cast<unsigned int>(recvBatchSize_), &savedErrno);
+        if (n <= 0)
+        {
+            if (n < 0 && savedErrno != EAGAIN && savedErrno != EWOULDBLOCK)
+                LOG_ERROR("UdpChannel::handleRead [%s] recvmmsg error:%d \n", name_.c_str(), savedErrno);
+            break;
+        }
+
+        datagrams_.clear();
+        for (int i = 0; i < n; ++i)
+        {
+            const struct msghdr &hdr = recvMsgs_[i].msg_hdr;
+            if (hdr.msg_flags & MSG_TRUNC)
+                ++truncated_;
+            const char *data = static_cast<const char *>(recvIovecs_[i].iov_base);
+            size_t len = recvMsgs_[i].msg_len;
+            size_t segmentSize = len;
+            if (groEnabled_)
+            {
+                // 合并包的控制消息里带着原始数据报的大小
+                for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<struct msghdr *>(&hdr), cmsg))
+                {
+                    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO)
+                    {
+                        int gsoSize = 0;
+                        memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+                        if (gsoSize > 0 && static_cast<size_t>(gsoSize) < len)
+                        {
+                            segmentSize = gsoSize;
+                            ++groPackets_;
+                        }
+                    }
+                }
+            }
+            // 按段大小切回一个个数据报，没有合并的包(包括空数据报)只有一段
+            size_t offset = 0;
+            do
+            {
+                datagrams_.push_back(Datagram{data + offset, std::min(segmentSize, len - offset), InetAddress((const sockaddr *)&recvAddrs_[i], hdr.msg_namelen)});
+                offset += segmentSize;
+            } while (offset < len);
+        }
+        received_ += datagrams_.size();
+        if (datagramCallback_)
+            datagramCallback_(guard, &datagrams_[0], datagrams_.size(), receiveTime);
+
+        // 没读满一批说明socket已经读空了
+        if (static_cast<size_t>(n) < recvBatchSize_)
+            break;
+    }
+    inReadCallback_ = false;
+    flush(); // 回调中产生的回复统一用一次sendmmsg发出去
+}
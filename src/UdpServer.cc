@@ -0,0 +1,65 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 16:51:14
+ * @LastEditTime: 2026-10-19 16:51:14
+ */
+#include "UdpServer.h"
+
+#include "Logger.h"
+#include "EventLoop.h"
+
+using namespace std;
+
+// 检查EventLoop是否为空
+static EventLoop *CheckLoopNotNull(EventLoop *loop)
+{
+    if (loop == nullptr)
+        LOG_FATAL("%s:%s:%d mainLoop is null \n", __FILE__, __FUNCTION__, __LINE__);
+    return loop;
+}
+
+UdpServer::UdpServer(EventLoop *loop, const InetAddress &listenAddr, const string &nameArg, Option option)
+    : loop_(CheckLoopNotNull(loop)),
+      listenAddr_(listenAddr),
+      name_(nameArg),
+      option_(option),
+      threadPool_(new EventLoopThreadPool(loop, name_)),
+      batchSize_(UdpChannel::kDefaultBatchSize),
+      maxDatagramSize_(UdpChannel::kDefaultMaxDatagramSize),
+      started_(0)
+{
+}
+
+UdpServer::~UdpServer()
+{
+    // UdpChannel要在自己的loop线程中从poller上移除
+    for (const UdpChannelPtr &channel : channels_)
+        channel->stop();
+}
+
+void UdpServer::start()
+{
+    // 防止一个UdpServer对象被start多次
+    if (started_++ == 0)
+    {
+        threadPool_->start(threadInitCallback_);
+        vector<EventLoop *> loops;
+        if (option_ == kReusePort)
+            loops = threadPool_->getAllGroups();
+        else
+            loops.push_back(loop_);
+
+        for (size_t i = 0; i < loops.size(); ++i)
+        {
+            char buf[32] = {0};
+            snprintf(buf, sizeof(buf), "-%s#%lu", listenAddr_.toIpPort().c_str(), i);
+            UdpChannelPtr channel = make_shared<UdpChannel>(loops[i], listenAddr_, name_ + buf,
+                                                            option_ == kReusePort, batchSize_, maxDatagramSize_);
+            channel->setDatagramCallback(datagramCallback_);
+            channels_.push_back(channel);
+            channel->start();
+        }
+        LOG_INFO("UdpServer::start [%s] - %lu socket(s) on %s \n",
+                 name_.c_str(), channels_.size(), listenAddr_.toIpPort().c_str());
+    }
+}
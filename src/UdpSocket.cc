@@ -0,0 +1,108 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 16:05:40
+ * @LastEditTime: 2026-10-19 16:05:40
+ */
+#include "UdpSocket.h"
+
+#include <errno.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#include "Logger.h"
+
+// 创建一个非阻塞的UDP socket
+static int createNonblocking(sa_family_t family)
+{
+    int sockfd = ::socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (sockfd < 0)
+        LOG_FATAL("%s:%s:%d udp socket create err:%d \n", __FILE__, __FUNCTION__, __LINE__, errno);
+    return sockfd;
+}
+
+const size_t UdpSocket::kMaxGsoSegments;
+const size_t UdpSocket::kMaxGsoBytes;
+
+UdpSocket::UdpSocket(sa_family_t family)
+    : socket_(createNonblocking(family))
+{
+}
+
+void UdpSocket::setRecvBufferSize(int bytes)
+{
+    if (::setsockopt(fd(), SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes)) < 0)
+        LOG_ERROR("setsockopt SO_RCVBUF error:%d \n", errno);
+}
+
+void UdpSocket::setSendBufferSize(int bytes)
+{
+    if (::setsockopt(fd(), SOL_SOCKET, SO_SNDBUF, &bytes, sizeof(bytes)) < 0)
+        LOG_ERROR("setsockopt SO_SNDBUF error:%d \n", errno);
+}
+
+int UdpSocket::recvBatch(struct mmsghdr *msgs, unsigned int count, int *saveErrno)
+{
+    int n = ::recvmmsg(fd(), msgs, count, MSG_DONTWAIT, nullptr);
+    if (n < 0)
+        *saveErrno = errno;
+    return n;
+}
+
+int UdpSocket::sendBatch(struct mmsghdr *msgs, unsigned int count, int *saveErrno)
+{
+    int n = ::sendmmsg(fd(), msgs, count, MSG_DONTWAIT);
+    if (n < 0)
+        *saveErrno = errno;
+    return n;
+}
+
+ssize_t UdpSocket::sendTo(const void *data, size_t len, const InetAddress &peer, int *saveErrno)
+{
+    ssize_t n = ::sendto(fd(), data, len, MSG_DONTWAIT, peer.getSockAddr(), peer.getSockLen());
+    if (n < 0)
+        *saveErrno = errno;
+    return n;
+}
+
+bool UdpSocket::setGro(bool on)
+{
+    int optval = on ? 1 : 0;
+    if (::setsockopt(fd(), IPPROTO_UDP, UDP_GRO, &optval, sizeof(optval)) < 0)
+    {
+        LOG_ERROR("setsockopt UDP_GRO error:%d \n", errno);
+        return false;
+    }
+    return true;
+}
+
+ssize_t UdpSocket::sendSegmented(const void *data, size_t len, uint16_t segmentSize, const InetAddress &peer, int *saveErrno)
+{
+    struct iovec iov;
+    iov.iov_base = const_cast<void *>(data);
+    iov.iov_len = len;
+
+    // 控制消息里带上UDP_SEGMENT，告诉内核按segmentSize切分
+    char control[CMSG_SPACE(sizeof(uint16_t))];
+    memset(control, 0, sizeof(control));
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = const_cast<sockaddr *>(peer.getSockAddr());
+    msg.msg_namelen = peer.getSockLen();
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+
+    ssize_t n = ::sendmsg(fd(), &msg, MSG_DONTWAIT);
+    if (n < 0)
+        *saveErrno = errno;
+    return n;
+}
@@ -0,0 +1,160 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 15:21:30
+ * @LastEditTime: 2026-10-19 15:21:30
+ */
+#include "UpstreamPool.h"
+
+#include "Logger.h"
+#include "EventLoop.h"
+#include "TcpClient.h"
+#include "TcpConnection.h"
+
+using namespace std;
+using namespace std::placeholders;
+
+const size_t UpstreamPool::kDefaultMaxInFlight;
+
+// 连接池析构后还没关闭的连接收到的数据直接丢弃
+static void discardMessage(const TcpConnectionPtr &, Buffer *buf, TimeStamp)
+{
+    buf->retrieveAll();
+}
+
+UpstreamPool::UpstreamPool(EventLoop *loop, const InetAddress &serverAddr, const string &name,
+                           int numConnections, const ResponseSplitter &splitter)
+    : loop_(loop),
+      name_(name),
+      splitter_(splitter),
+      maxInFlight_(kDefaultMaxInFlight),
+      upstreams_(numConnections)
+{
+    for (int i = 0; i < numConnections; ++i)
+    {
+        char buf[32] = {0};
+        snprintf(buf, sizeof(buf), "-%d", i);
+        Upstream &upstream = upstreams_[i];
+        upstream.client.reset(new TcpClient(loop, serverAddr, name_ + buf));
+        upstream.client->setConnectionCallback(bind(&UpstreamPool::onConnection, this, i, _1));
+        upstream.client->setMessageCallback(bind(&UpstreamPool::onMessage, this, i, _1, _2, _3));
+        upstream.client->enableRetry();
+    }
+}
+
+UpstreamPool::~UpstreamPool()
+{
+    for (Upstream &upstream : upstreams_)
+    {
+        failPending(upstream);
+        if (upstream.conn)
+        {
+            // 连接可能比连接池活得久，不能再回调到this
+            upstream.conn->setConnectionCallback(ConnectionCallback());
+            upstream.conn->setMessageCallback(discardMessage);
+            upstream.conn.reset(); // 释放引用，TcpClient析构时才会强制关闭连接
+        }
+    }
+}
+
+void UpstreamPool::start()
+{
+    for (Upstream &upstream : upstreams_)
+        upstream.client->connect();
+}
+
+void UpstreamPool::stop()
+{
+    for (Upstream &upstream : upstreams_)
+    {
+        upstream.client->stop();
+        upstream.client->disconnect();
+    }
+}
+
+bool UpstreamPool::call(const string &request, const ResponseCallback &cb)
+{
+    if (!loop_->isInLoopThread())
+    {
+        LOG_ERROR("UpstreamPool::call [%s] - must be called in loop thread \n", name_.c_str());
+        return false;
+    }
+
+    // least outstanding：挑排队请求最少的可用连接
+    Upstream *best = nullptr;
+    for (Upstream &upstream : upstreams_)
+    {
+        if (!upstream.conn || upstream.pending.size() >= maxInFlight_)
+            continue;
+        if (best == nullptr || upstream.pending.size() < best->pending.size())
+            best = &upstream;
+    }
+    if (best == nullptr)
+        return false;
+
+    // 先入队再发送，保证响应到达时回调已经在队列里
+    best->pending.push_back(cb);
+    best->conn->send(request);
+    return true;
+}
+
+size_t UpstreamPool::connectedCount() const
+{
+    size_t count = 0;
+    for (const Upstream &upstream : upstreams_)
+        if (upstream.conn)
+            ++count;
+    return count;
+}
+
+size_t UpstreamPool::inFlight() const
+{
+    size_t count = 0;
+    for (const Upstream &upstream : upstreams_)
+        count += upstream.pending.size();
+    return count;
+}
+
+void UpstreamPool::onConnection(size_t index, const TcpConnectionPtr &conn)
+{
+    Upstream &upstream = upstreams_[index];
+    if (conn->connected())
+    {
+        conn->setTcpNoDelay(true); // 小请求不等Nagle攒包
+        upstream.conn = conn;
+    }
+    else
+    {
+        LOG_INFO("UpstreamPool [%s] - connection %s down, %lu requests failed \n",
+                 name_.c_str(), conn->name().c_str(), upstream.pending.size());
+        upstream.conn.reset();
+        failPending(upstream);
+    }
+}
+
+void UpstreamPool::onMessage(size_t index, const TcpConnectionPtr &conn, Buffer *buf, TimeStamp /*receiveTime*/)
+{
+    Upstream &upstream = upstreams_[index];
+    size_t len = 0;
+    while (buf->readableBytes() > 0 && (len = splitter_(buf)) > 0)
+    {
+        string response(buf->peek(), len);
+        buf->retrieve(len);
+        if (upstream.pending.empty())
+        {
+            LOG_ERROR("UpstreamPool [%s] - unexpected response on %s \n", name_.c_str(), conn->name().c_str());
+            continue;
+        }
+        ResponseCallback cb = std::move(upstream.pending.front());
+        upstream.pending.pop_front();
+        cb(true, response);
+    }
+}
+
+void UpstreamPool::failPending(Upstream &upstream)
+{
+    // 先换出来再回调，回调里可能会再次call
+    std::deque<ResponseCallback> pending;
+    pending.swap(upstream.pending);
+    for (const ResponseCallback &cb : pending)
+        cb(false, string());
+}
@@ -0,0 +1,177 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:15:58
+ * @LastEditTime: 2026-10-19 21:15:58
+ */
+#include "WebSocketCodec.h"
+#include "Buffer.h"
+#include "Sha1.h"
+#include "Base64.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#endif
+
+int WebSocketCodec::parseHeader(const char *data, size_t len, FrameHeader *header)
+{
+    if (len < 2)
+        return 0;
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(data);
+    header->fin = (p[0] & 0x80) != 0;
+    header->opcode = p[0] & 0x0F;
+    header->masked = (p[1] & 0x80) != 0;
+
+    // 没有协商扩展，保留位必须为0
+    if ((p[0] & 0x70) != 0)
+        return -1;
+    switch (header->opcode)
+    {
+    case kContinuation:
+    case kText:
+    case kBinary:
+        break;
+    case kClose:
+    case kPing:
+    case kPong:
+        // 控制帧不能分片，负载不超过125字节
+        if (!header->fin || (p[1] & 0x7F) > kMaxControlPayload)
+            return -1;
+        break;
+    default:
+        return -1;
+    }
+
+    size_t pos = 2;
+    uint64_t payloadLen = p[1] & 0x7F;
+    if (payloadLen == 126)
+    {
+        if (len < pos + 2)
+            return 0;
+        payloadLen = (static_cast<uint64_t>(p[2]) << 8) | p[3];
+        pos += 2;
+    }
+    else if (payloadLen == 127)
+    {
+        if (len < pos + 8)
+            return 0;
+        payloadLen = 0;
+        for (int i = 0; i < 8; ++i)
+            payloadLen = (payloadLen << 8) | p[pos + i];
+        if (payloadLen >> 63)
+            return -1; // 最高位必须为0
+        pos += 8;
+    }
+
+    if (header->masked)
+    {
+        if (len < pos + 4)
+            return 0;
+        memcpy(header->maskKey, p + pos, 4);
+        pos += 4;
+    }
+    header->headerLen = pos;
+    header->payloadLen = payloadLen;
+    return 1;
+}
+
+void WebSocketCodec::applyMask(char *data, size_t len, const uint8_t *maskKey)
+{
+    // 掩码以4字节为周期，把它重复铺满一个机器字/SIMD寄存器后整块异或，结尾不足一块的逐字节处理
+    uint32_t key32;
+    memcpy(&key32, maskKey, 4);
+    size_t i = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+    const __m128i key128 = _mm_set1_epi32(static_cast<int>(key32));
+    for (; i + 64 <= len; i += 64)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 48));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm_xor_si128(a, key128));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i + 16), _mm_xor_si128(b, key128));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i + 32), _mm_xor_si128(c, key128));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i + 48), _mm_xor_si128(d, key128));
+    }
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm_xor_si128(a, key128));
+    }
+#endif
+
+    const uint64_t key64 = (static_cast<uint64_t>(key32) << 32) | key32;
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        word ^= key64;
+        memcpy(data + i, &word, 8);
+    }
+    // 上面每次处理的字节数都是4的倍数，所以这里从掩码的第0个字节开始
+    for (size_t j = 0; i < len; ++i, ++j)
+        data[i] ^= maskKey[j & 3];
+}
+
+size_t WebSocketCodec::writeHeader(char *header, int opcode, size_t payloadLen)
+{
+    uint8_t *p = reinterpret_cast<uint8_t *>(header);
+    p[0] = static_cast<uint8_t>(0x80 | (opcode & 0x0F)); // 服务端发出的消息不分片
+    if (payloadLen < 126)
+    {
+        p[1] = static_cast<uint8_t>(payloadLen);
+        return 2;
+    }
+    if (payloadLen <= 0xFFFF)
+    {
+        p[1] = 126;
+        p[2] = static_cast<uint8_t>(payloadLen >> 8);
+        p[3] = static_cast<uint8_t>(payloadLen);
+        return 4;
+    }
+    p[1] = 127;
+    uint64_t len64 = payloadLen;
+    for (int i = 0; i < 8; ++i)
+        p[9 - i] = static_cast<uint8_t>(len64 >> (i * 8));
+    return 10;
+}
+
+void WebSocketCodec::encode(Buffer *out, int opcode, const StringPiece &payload)
+{
+    char header[kMaxHeaderLen];
+    size_t headerLen = writeHeader(header, opcode, payload.size());
+    out->ensureWritableBytes(headerLen + payload.size());
+    out->append(header, headerLen);
+    out->append(payload.data(), payload.size());
+}
+
+std::string WebSocketCodec::encodeToString(int opcode, const StringPiece &payload)
+{
+    char header[kMaxHeaderLen];
+    size_t headerLen = writeHeader(header, opcode, payload.size());
+    std::string frame;
+    frame.reserve(headerLen + payload.size());
+    frame.append(header, headerLen);
+    frame.append(payload.data(), payload.size());
+    return frame;
+}
+
+void WebSocketCodec::prependHeader(Buffer *payload, int opcode)
+{
+    char header[kMaxHeaderLen];
+    size_t headerLen = writeHeader(header, opcode, payload->readableBytes());
+    payload->prepend(header, headerLen);
+}
+
+std::string WebSocketCodec::acceptKey(const StringPiece &clientKey)
+{
+    static const char kGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    std::string input(clientKey.data(), clientKey.size());
+    input.append(kGuid, sizeof(kGuid) - 1);
+    uint8_t digest[Sha1::kDigestLength];
+    Sha1::digest(input.data(), input.size(), digest);
+    return Base64::encode(digest, sizeof digest);
+}
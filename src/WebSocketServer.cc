@@ -0,0 +1,309 @@
+/*
+ * @Author: lvxr
+ * @Date: 2026-10-19 21:36:20
+ * @LastEditTime: 2026-10-19 21:36:20
+ */
+#include "WebSocketServer.h"
+#include "WebSocketCodec.h"
+#include "HttpParser.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "TcpConnection.h"
+#include "EventLoop.h"
+#include "Logger.h"
+
+#include <memory>
+#include <string.h>
+
+using namespace std::placeholders;
+
+namespace
+{
+    // 每个连接的状态，保存在TcpConnection的context中
+    struct WebSocketContext
+    {
+        enum State
+        {
+            kHandshake, // 等待握手请求
+            kOpen,      // 握手完成，收发数据帧
+            kClosing    // 已经发送了关闭帧，不再处理数据帧
+        };
+
+        WebSocketContext() : state(kHandshake), fragmentOpcode(WebSocketCodec::kContinuation) {}
+
+        State state;
+        HttpParser parser;     // 握手阶段使用
+        int fragmentOpcode;    // 正在接收的分片消息的类型，kContinuation表示没有
+        std::string fragments; // 分片消息已经收到的部分
+    };
+
+    WebSocketContext *getContext(const TcpConnectionPtr &conn)
+    {
+        return static_cast<WebSocketContext *>(conn->getContext().get());
+    }
+
+    // 在IO线程中把一个帧写入outputBuffer_并发送
+    void sendFrameInLoop(const TcpConnectionPtr &conn, int opcode, const StringPiece &payload)
+    {
+        if (!conn->connected())
+            return;
+        WebSocketCodec::encode(conn->outputBuffer(), opcode, payload);
+        conn->flush();
+    }
+
+    // 在IO线程中发送关闭帧，然后关闭写端
+    void closeInLoop(const TcpConnectionPtr &conn, int code, const StringPiece &reason)
+    {
+        WebSocketContext *context = getContext(conn);
+        if (context != nullptr && context->state == WebSocketContext::kOpen)
+        {
+            context->state = WebSocketContext::kClosing;
+            char payload[WebSocketCodec::kMaxControlPayload];
+            size_t len = reason.size() > sizeof(payload) - 2 ? sizeof(payload) - 2 : reason.size();
+            payload[0] = static_cast<char>(code >> 8);
+            payload[1] = static_cast<char>(code);
+            memcpy(payload + 2, reason.data(), len);
+            sendFrameInLoop(conn, WebSocketCodec::kClose, StringPiece(payload, len + 2));
+        }
+        conn->shutdown();
+    }
+
+    void defaultHttpCallback(const HttpRequest &, HttpResponse *resp)
+    {
+        resp->setStatusCode(HttpResponse::k426UpgradeRequired);
+        resp->addHeader("Sec-WebSocket-Version", "13");
+        resp->setBody("Upgrade Required");
+    }
+}
+
+WebSocketServer::WebSocketServer(EventLoop *loop, const InetAddress &listenAddr, const std::string &name, TcpServer::Option option)
+    : server_(loop, listenAddr, name, option),
+      httpCallback_(defaultHttpCallback),
+      maxMessageSize_(kDefaultMaxMessageSize)
+{
+    server_.setConnectionCallback(std::bind(&WebSocketServer::onConnection, this, _1));
+    server_.setMessageCallback(std::bind(&WebSocketServer::onMessage, this, _1, _2, _3));
+}
+
+void WebSocketServer::onConnection(const TcpConnectionPtr &conn)
+{
+    if (conn->connected())
+    {
+        conn->setContext(std::make_shared<WebSocketContext>());
+    }
+    else
+    {
+        // 只有握手成功过的连接才通知上层断开
+        WebSocketContext *context = getContext(conn);
+        if (context != nullptr && context->state != WebSocketContext::kHandshake && connectionCallback_)
+            connectionCallback_(conn);
+    }
+}
+
+void WebSocketServer::onMessage(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    WebSocketContext *context = getContext(conn);
+    if (context == nullptr || !conn->connected())
+    {
+        buf->retrieveAll();
+        return;
+    }
+
+    if (context->state == WebSocketContext::kHandshake && !handleHandshake(conn, buf, receiveTime))
+        return;
+    // 客户端可能把握手请求和第一帧放在同一个包里，握手之后接着解析剩下的数据
+    handleFrames(conn, buf, receiveTime);
+}
+
+bool WebSocketServer::handleHandshake(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    WebSocketContext *context = getContext(conn);
+    HttpParser &parser = context->parser;
+    while (true)
+    {
+        HttpParser::Result result = parser.parse(buf, receiveTime);
+        if (result == HttpParser::kIncomplete)
+            return false;
+        if (result == HttpParser::kError)
+        {
+            HttpResponse response(conn->outputBuffer(), true);
+            response.setStatusCode(parser.errorCode());
+            response.setBody(HttpResponse::statusMessage(parser.errorCode()));
+            buf->retrieveAll();
+            conn->flush();
+            conn->shutdown();
+            return false;
+        }
+
+        const HttpRequest &request = parser.request();
+        if (!request.hasHeaderToken("Upgrade", "websocket"))
+        {
+            // 普通HTTP请求，处理完继续等待下一个请求
+            HttpResponse response(conn->outputBuffer(), !request.keepAlive(), request.method() == HttpRequest::kHead);
+            httpCallback_(request, &response);
+            response.finish();
+            parser.consume(buf);
+            conn->flush();
+            if (response.closeConnection())
+            {
+                conn->shutdown();
+                return false;
+            }
+            continue;
+        }
+
+        int status = HttpResponse::k101SwitchingProtocols;
+        StringPiece key = request.getHeader("Sec-WebSocket-Key");
+        if (request.method() != HttpRequest::kGet || request.version() != HttpRequest::kHttp11 ||
+            !request.hasHeaderToken("Connection", "upgrade") || key.empty())
+            status = HttpResponse::k400BadRequest;
+        else if (request.getHeader("Sec-WebSocket-Version") != "13")
+            status = HttpResponse::k426UpgradeRequired;
+        else if (handshakeCallback_ && !handshakeCallback_(conn, request))
+            status = HttpResponse::k403Forbidden;
+
+        HttpResponse response(conn->outputBuffer(), status != HttpResponse::k101SwitchingProtocols);
+        response.setStatusCode(status);
+        if (status == HttpResponse::k101SwitchingProtocols)
+        {
+            response.addHeader("Upgrade", "websocket");
+            response.addHeader("Sec-WebSocket-Accept", WebSocketCodec::acceptKey(key));
+            response.finish();
+            parser.consume(buf);
+            conn->flush();
+            context->state = WebSocketContext::kOpen;
+            if (connectionCallback_)
+                connectionCallback_(conn);
+            return true;
+        }
+
+        if (status == HttpResponse::k426UpgradeRequired)
+            response.addHeader("Sec-WebSocket-Version", "13");
+        response.setBody(HttpResponse::statusMessage(status));
+        buf->retrieveAll();
+        conn->flush();
+        conn->shutdown();
+        return false;
+    }
+}
+
+void WebSocketServer::handleFrames(const TcpConnectionPtr &conn, Buffer *buf, TimeStamp receiveTime)
+{
+    WebSocketContext *context = getContext(conn);
+    while (context->state != WebSocketContext::kHandshake && conn->connected())
+    {
+        WebSocketCodec::FrameHeader header;
+        int result = WebSocketCodec::parseHeader(buf->peek(), buf->readableBytes(), &header);
+        if (result == 0)
+            break;
+        // 客户端发来的帧必须带掩码
+        if (result < 0 || !header.masked)
+        {
+            buf->retrieveAll();
+            closeInLoop(conn, WebSocketCodec::kProtocolError, StringPiece());
+            break;
+        }
+        if (header.payloadLen > maxMessageSize_ || context->fragments.size() + header.payloadLen > maxMessageSize_)
+        {
+            buf->retrieveAll();
+            closeInLoop(conn, WebSocketCodec::kMessageTooBig, StringPiece());
+            break;
+        }
+        size_t frameLen = header.headerLen + static_cast<size_t>(header.payloadLen);
+        if (buf->readableBytes() < frameLen)
+            break;
+
+        // 就地去掩码，负载直接指向inputBuffer_
+        char *payload = buf->peek() + header.headerLen;
+        size_t payloadLen = static_cast<size_t>(header.payloadLen);
+        WebSocketCodec::applyMask(payload, payloadLen, header.maskKey);
+        StringPiece data(payload, payloadLen);
+
+        if (context->state == WebSocketContext::kClosing && header.opcode != WebSocketCodec::kClose)
+        {
+            // 已经发出关闭帧，丢弃后面的数据帧
+        }
+        else if (header.opcode == WebSocketCodec::kPing)
+        {
+            sendFrameInLoop(conn, WebSocketCodec::kPong, data);
+        }
+        else if (header.opcode == WebSocketCodec::kPong)
+        {
+        }
+        else if (header.opcode == WebSocketCodec::kClose)
+        {
+            int code = payloadLen >= 2 ? (static_cast<uint8_t>(payload[0]) << 8) | static_cast<uint8_t>(payload[1]) : WebSocketCodec::kNormalClosure;
+            buf->retrieve(frameLen);
+            closeInLoop(conn, code, StringPiece());
+            break;
+        }
+        else if (header.opcode == WebSocketCodec::kContinuation)
+        {
+            if (context->fragmentOpcode == WebSocketCodec::kContinuation)
+            {
+                buf->retrieveAll();
+                closeInLoop(conn, WebSocketCodec::kProtocolError, StringPiece());
+                break;
+            }
+            context->fragments.append(data.data(), data.size());
+            if (header.fin)
+            {
+                bool binary = context->fragmentOpcode == WebSocketCodec::kBinary;
+                context->fragmentOpcode = WebSocketCodec::kContinuation;
+                if (messageCallback_)
+                    messageCallback_(conn, context->fragments, binary, receiveTime);
+                context->fragments.clear();
+            }
+        }
+        else
+        {
+            // 新的文本/二进制消息，前一个分片消息还没结束是协议错误
+            if (context->fragmentOpcode != WebSocketCodec::kContinuation)
+            {
+                buf->retrieveAll();
+                closeInLoop(conn, WebSocketCodec::kProtocolError, StringPiece());
+                break;
+            }
+            if (header.fin)
+            {
+                if (messageCallback_)
+                    messageCallback_(conn, data, header.opcode == WebSocketCodec::kBinary, receiveTime);
+            }
+            else
+            {
+                context->fragmentOpcode = header.opcode;
+                context->fragments.assign(data.data(), data.size());
+            }
+        }
+        buf->retrieve(frameLen);
+    }
+}
+
+void WebSocketServer::send(const TcpConnectionPtr &conn, const StringPiece &message, bool binary)
+{
+    int opcode = binary ? WebSocketCodec::kBinary : WebSocketCodec::kText;
+    if (conn->getLoop()->isInLoopThread())
+        sendFrameInLoop(conn, opcode, message);
+    else
+        conn->send(SharedPayload(WebSocketCodec::encodeToString(opcode, message)));
+}
+
+void WebSocketServer::close(const TcpConnectionPtr &conn, int code, const StringPiece &reason)
+{
+    EventLoop *loop = conn->getLoop();
+    if (loop->isInLoopThread())
+        closeInLoop(conn, code, reason);
+    else
+    {
+        std::string reasonCopy = reason.toString();
+        loop->queueInLoop([conn, code, reasonCopy]()
+                          { closeInLoop(conn, code, reasonCopy); });
+    }
+}
+
+void WebSocketServer::broadcast(const std::vector<TcpConnectionPtr> &conns, const StringPiece &message, bool binary)
+{
+    // 帧只编码一次，所有订阅者的发送链上排队的都是同一份数据的引用
+    SharedPayload frame(WebSocketCodec::encodeToString(binary ? WebSocketCodec::kBinary : WebSocketCodec::kText, message));
+    TcpServer::broadcast(conns, frame);
+}